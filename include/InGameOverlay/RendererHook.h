@@ -1,233 +1,432 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#pragma once
-
-#include <functional>
-#include <cstdint>
-
-#include "RendererResource.h"
-
-namespace InGameOverlay {
-
-enum class ToggleKey
-{
-    SHIFT, CTRL, ALT,
-    TAB,
-    F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12,
-};
-
-enum class OverlayHookState : uint8_t
-{
-    Ready,
-    Reset,
-    Removing,
-};
-
-/// <summary>
-/// Only one RendererHookType_t will always be returned by RendererHook_t::GetRendererHookType
-/// but you can use them as flags to limit the detection in InGameOverlay::DetectRenderer.
-/// NOTE: Even if a DirectX hook has been found and DXVK is used, the renderer hook will only report the DirectX hook type.
-/// There is no combination like : DirectX11 | Vulkan returned by RendererHook_t::GetRendererHookType.
-/// </summary>
-enum class RendererHookType_t : uint8_t
-{
-    DirectX9   = 1 << 0,
-    DirectX10  = 1 << 1,
-    DirectX11  = 1 << 2,
-    DirectX12  = 1 << 3,
-    OpenGL     = 1 << 4,
-    Vulkan     = 1 << 5,
-    Metal      = 1 << 6,
-    AnyDirectX = DirectX9 | DirectX10 | DirectX11 | DirectX12,
-    AnyWindows = DirectX9 | DirectX10 | DirectX11 | DirectX12 | OpenGL | Vulkan,
-    AnyLinux   = OpenGL | Vulkan,
-    AnyMacOS   = OpenGL | Metal,
-    Any        = DirectX9 | DirectX10 | DirectX11 | DirectX12 | OpenGL | Vulkan | Metal,
-};
-
-enum class ScreenshotType_t : uint8_t
-{
-    None = 0,
-    BeforeOverlay = 1,
-    AfterOverlay = 2,
-};
-
-enum class ScreenshotDataFormat_t : uint16_t
-{
-    Unknown = 0,
-    // 8-bit formats
-    R8G8B8,
-    X8R8G8B8,
-    A8R8G8B8,
-    B8G8R8A8,
-    B8G8R8X8,
-    R8G8B8A8,
-
-    // 10-bit formats
-    A2R10G10B10,
-    A2B10G10R10,
-    R10G10B10A2,
-
-    // 16-bit formats
-    R5G6B5,
-    X1R5G5B5,
-    A1R5G5B5,
-    B5G6R5,
-    B5G5R5A1,
-
-    // HDR / float formats
-    R16G16B16A16_FLOAT,
-    R16G16B16A16_UNORM,
-    R32G32B32A32_FLOAT,
-};
-
-/// <summary>
-///   The screenshot pixels data and format. To copy this buffer, you can reserve Width * Height * PixelSize bytes, but you will need to
-///   copy row by row because of the pitch.
-/// </summary>
-struct ScreenshotCallbackParameter_t
-{
-    uint32_t Width;
-    uint32_t Height;
-    uint32_t PixelSize;
-    uint32_t Pitch;
-    void* Data;
-    ScreenshotDataFormat_t Format;
-};
-
-typedef void (*ScreenshotCallback_t)(ScreenshotCallbackParameter_t const* screenshot, void* userParameter);
-
-/// <summary>
-///   The renderer hook.
-///     ResourceAutoLoad_t: Default value is ResourceAutoLoad_t::Batch
-///     BatchSize: Default value is 10
-/// </summary>
-class RendererHook_t
-{
-
-public:
-    virtual ~RendererHook_t() {}
-
-    // TODO: Deprecated direct use of thoses and use either a setter or plain C function pointers with void* user parameter.
-    std::function<void()> OverlayProc;
-    std::function<void(OverlayHookState)> OverlayHookReady;
-
-    virtual void SetScreenshotCallback(ScreenshotCallback_t callback, void* userParam) = 0;
-
-    /// <summary>
-    ///   Starts the current renderer hook procedure, allowing a user to render things on the application window.
-    /// </summary>
-    /// <param name="key_combination_callback">
-    ///   Callback called when your toggle_keys are all pressed.
-    /// </param>
-    /// <param name="toggle_keys">
-    ///   The key combination that must be pressed to show/hide your overlay.
-    /// </param>
-    /// <param name="imgui_font_atlas">
-    ///   *Can be nullptr*. Fill this parameter with your own ImGuiAtlas pointer if you don't want ImGui to generate one for you.
-    /// </param>
-    /// <returns></returns>
-    virtual bool StartHook(std::function<void()> keyCombinationCallback, ToggleKey toggleKeys[], int toggleKeysCount, /*ImFontAtlas* */ void* imguiFontAtlas = nullptr) = 0;
-
-    /// <summary>
-    ///   Change the hooked application input policy.
-    /// </summary>
-    /// <param name="hide">
-    ///   Set to true to hide mouse and keyboards inputs from the hooked application.
-    ///   Set to false to allow the hooked application to receive inputs.
-    /// </param>
-    /// <returns></returns>
-    virtual void HideAppInputs(bool hide) = 0;
-    
-    /// <summary>
-    ///   Change the overlay input policy.
-    /// </summary>
-    /// <param name="hide">
-    ///   Set to true to hide mouse and keyboards inputs from the overlay.
-    ///   Set to false to allow the overlay to receive inputs.
-    /// </param>
-    /// <returns></returns>
-    virtual void HideOverlayInputs(bool hide) = 0;
-
-    /// <summary>
-    ///   Returns the hook state. If its started, then the functions are hooked (redirected to InGameOverlay) and will intercepts the application frame rendering.
-    /// </summary>
-    /// <returns></returns>
-    virtual bool IsStarted() = 0;
-
-    /// <summary>
-    ///   Get the current renderer library name.
-    /// </summary>
-    /// <returns></returns>
-    virtual const char* GetLibraryName() const = 0;
-
-    /// <summary>
-    ///   Get the current renderer hook type.
-    /// </summary>
-    /// <returns></returns>
-    virtual RendererHookType_t GetRendererHookType() const = 0;
-
-    /// <summary>
-    ///   Gets the auto load batch size.
-    /// </summary>
-    /// <returns></returns>
-    virtual uint32_t GetAutoLoadBatchSize() = 0;
-
-    /// <summary>
-    ///   Sets how many resources the renderer hook can load before rendering the frame, to not block the rendering with a hundred of resource to load.
-    /// </summary>
-    /// <param name="batchSize"></param>
-    virtual void SetAutoLoadBatchSize(uint32_t batchSize) = 0;
-
-    /// <summary>
-    ///   Creates an image resource that can be setup and used later.
-    /// </summary>
-    /// <returns></returns>
-    virtual RendererResource_t* CreateResource() = 0;
-
-    /// <summary>
-    ///   Creates an image resource and attach the data to it.
-    /// </summary>
-    /// <param name="image_data">
-    ///   The RGBA buffer.
-    /// </param>
-    /// <param name="width">
-    ///   Your RGBA image width.
-    /// </param>
-    /// <param name="height">
-    ///   Your RGBA image height.
-    /// </param>
-    /// <returns></returns>
-    virtual RendererResource_t* CreateAndAttachResource(const void* image_data, uint32_t width, uint32_t height) = 0;
-
-    virtual void TakeScreenshot(ScreenshotType_t type) = 0;
-};
-
-}
-
-inline InGameOverlay::RendererHookType_t operator&(InGameOverlay::RendererHookType_t l, InGameOverlay::RendererHookType_t r)
-{
-    return static_cast<InGameOverlay::RendererHookType_t>(static_cast<uint8_t>(l) & static_cast<uint8_t>(r));
-}
-
-inline InGameOverlay::RendererHookType_t operator|(InGameOverlay::RendererHookType_t l, InGameOverlay::RendererHookType_t r)
-{
-    return static_cast<InGameOverlay::RendererHookType_t>(static_cast<uint8_t>(l) | static_cast<uint8_t>(r));
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <cstdint>
+
+#include "RendererResource.h"
+
+namespace InGameOverlay {
+
+enum class ToggleKey
+{
+    SHIFT, CTRL, ALT,
+    TAB,
+    F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12,
+};
+
+enum class OverlayHookState : uint8_t
+{
+    Ready,
+    Reset,
+    Removing,
+};
+
+/// <summary>
+/// Only one RendererHookType_t will always be returned by RendererHook_t::GetRendererHookType
+/// but you can use them as flags to limit the detection in InGameOverlay::DetectRenderer.
+/// NOTE: Even if a DirectX hook has been found and DXVK is used, the renderer hook will only report the DirectX hook type.
+/// There is no combination like : DirectX11 | Vulkan returned by RendererHook_t::GetRendererHookType.
+/// </summary>
+enum class RendererHookType_t : uint8_t
+{
+    DirectX9   = 1 << 0,
+    DirectX10  = 1 << 1,
+    DirectX11  = 1 << 2,
+    DirectX12  = 1 << 3,
+    OpenGL     = 1 << 4,
+    Vulkan     = 1 << 5,
+    Metal      = 1 << 6,
+    AnyDirectX = DirectX9 | DirectX10 | DirectX11 | DirectX12,
+    AnyWindows = DirectX9 | DirectX10 | DirectX11 | DirectX12 | OpenGL | Vulkan,
+    AnyLinux   = OpenGL | Vulkan,
+    AnyMacOS   = OpenGL | Metal,
+    Any        = DirectX9 | DirectX10 | DirectX11 | DirectX12 | OpenGL | Vulkan | Metal,
+};
+
+enum class ScreenshotType_t : uint8_t
+{
+    None = 0,
+    BeforeOverlay = 1,
+    AfterOverlay = 2,
+};
+
+enum class ScreenshotDataFormat_t : uint16_t
+{
+    Unknown = 0,
+    // 8-bit formats
+    R8G8B8,
+    X8R8G8B8,
+    A8R8G8B8,
+    B8G8R8A8,
+    B8G8R8X8,
+    R8G8B8A8,
+
+    // 10-bit formats
+    A2R10G10B10,
+    A2B10G10R10,
+    R10G10B10A2,
+
+    // 16-bit formats
+    R5G6B5,
+    X1R5G5B5,
+    A1R5G5B5,
+    B5G6R5,
+    B5G5R5A1,
+
+    // HDR / float formats
+    R16G16B16A16_FLOAT,
+    R16G16B16A16_UNORM,
+    R32G32B32A32_FLOAT,
+};
+
+/// <summary>
+///   The screenshot pixels data and format. To copy this buffer, you can reserve Width * Height * PixelSize bytes, but you will need to
+///   copy row by row because of the pitch.
+///   Some renderers read the pixels back asynchronously and call the callback a few frames after the screenshot was taken,
+///   FrameIndex is the renderer frame the screenshot was taken at.
+/// </summary>
+struct ScreenshotCallbackParameter_t
+{
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t PixelSize;
+    uint32_t Pitch;
+    void* Data;
+    ScreenshotDataFormat_t Format;
+    uint64_t FrameIndex;
+};
+
+/// <summary>
+///   The texture memory usage of the renderers that sub-allocate the device memory of their textures (Vulkan).
+///   The fragmentation can be computed with 1 - LargestFreeRange / (BlockBytes - UsedBytes).
+/// </summary>
+struct RendererTextureMemoryStats_t
+{
+    // Device memory allocations made for the textures and their total size in bytes.
+    uint64_t BlockCount;
+    uint64_t BlockBytes;
+    // Textures placed in the blocks and the bytes they use. The padding before an aligned texture stays free, it is not counted here.
+    uint64_t AllocationCount;
+    uint64_t UsedBytes;
+    // Free ranges left in the blocks and the biggest one in bytes, the small ones are mostly alignment padding.
+    uint64_t FreeRangeCount;
+    uint64_t LargestFreeRange;
+};
+
+struct RendererResidencyStats_t
+{
+    // Bytes of the resource textures currently loaded and the budget they are kept under, 0 when it is not limited.
+    uint64_t ResidentBytes;
+    uint64_t BudgetBytes;
+    uint64_t ResidentCount;
+    // Textures unloaded to stay under the budget and their size, they are loaded again from their attached data when used.
+    uint64_t EvictionCount;
+    uint64_t EvictedBytes;
+};
+
+typedef void (*ScreenshotCallback_t)(ScreenshotCallbackParameter_t const* screenshot, void* userParameter);
+
+/// <summary>
+///   The renderer hook.
+///     ResourceAutoLoad_t: Default value is ResourceAutoLoad_t::Batch
+///     BatchSize: Default value is 10
+///     AutoLoadByteBudget: Default value is 16MiB
+///     AutoLoadTimeBudget: Default value is 2000us
+///     UploadBufferSize: Default value is 16MiB
+///     TextureMemoryBudget: Default value is 0, not limited
+///     ResourceDeduplication: Default value is false
+/// </summary>
+class RendererHook_t
+{
+
+public:
+    virtual ~RendererHook_t() {}
+
+    // TODO: Deprecated direct use of thoses and use either a setter or plain C function pointers with void* user parameter.
+    std::function<void()> OverlayProc;
+    std::function<void(OverlayHookState)> OverlayHookReady;
+
+    virtual void SetScreenshotCallback(ScreenshotCallback_t callback, void* userParam) = 0;
+
+    /// <summary>
+    ///   Starts the current renderer hook procedure, allowing a user to render things on the application window.
+    /// </summary>
+    /// <param name="key_combination_callback">
+    ///   Callback called when your toggle_keys are all pressed.
+    /// </param>
+    /// <param name="toggle_keys">
+    ///   The key combination that must be pressed to show/hide your overlay.
+    /// </param>
+    /// <param name="imgui_font_atlas">
+    ///   *Can be nullptr*. Fill this parameter with your own ImGuiAtlas pointer if you don't want ImGui to generate one for you.
+    /// </param>
+    /// <returns></returns>
+    virtual bool StartHook(std::function<void()> keyCombinationCallback, ToggleKey toggleKeys[], int toggleKeysCount, /*ImFontAtlas* */ void* imguiFontAtlas = nullptr) = 0;
+
+    /// <summary>
+    ///   Change the hooked application input policy.
+    /// </summary>
+    /// <param name="hide">
+    ///   Set to true to hide mouse and keyboards inputs from the hooked application.
+    ///   Set to false to allow the hooked application to receive inputs.
+    /// </param>
+    /// <returns></returns>
+    virtual void HideAppInputs(bool hide) = 0;
+    
+    /// <summary>
+    ///   Change the overlay input policy.
+    /// </summary>
+    /// <param name="hide">
+    ///   Set to true to hide mouse and keyboards inputs from the overlay.
+    ///   Set to false to allow the overlay to receive inputs.
+    /// </param>
+    /// <returns></returns>
+    virtual void HideOverlayInputs(bool hide) = 0;
+
+    /// <summary>
+    ///   Returns the hook state. If its started, then the functions are hooked (redirected to InGameOverlay) and will intercepts the application frame rendering.
+    /// </summary>
+    /// <returns></returns>
+    virtual bool IsStarted() = 0;
+
+    /// <summary>
+    ///   Get the current renderer library name.
+    /// </summary>
+    /// <returns></returns>
+    virtual const char* GetLibraryName() const = 0;
+
+    /// <summary>
+    ///   Get the current renderer hook type.
+    /// </summary>
+    /// <returns></returns>
+    virtual RendererHookType_t GetRendererHookType() const = 0;
+
+    /// <summary>
+    ///   Gets the auto load batch size.
+    /// </summary>
+    /// <returns></returns>
+    virtual uint32_t GetAutoLoadBatchSize() = 0;
+
+    /// <summary>
+    ///   Sets how many resources the renderer hook can load before rendering the frame, to not block the rendering with a hundred of resource to load.
+    ///   0 doesn't limit the count, the byte and time budgets still apply.
+    /// </summary>
+    /// <param name="batchSize"></param>
+    virtual void SetAutoLoadBatchSize(uint32_t batchSize) = 0;
+
+    /// <summary>
+    ///   Gets the auto load byte budget.
+    /// </summary>
+    /// <returns></returns>
+    virtual uint32_t GetAutoLoadByteBudget() = 0;
+
+    /// <summary>
+    ///   Sets how many bytes of images the renderer hook can upload before rendering the frame, 0 to not limit it.
+    ///   At least one resource is loaded each frame, even if it is bigger than the budget.
+    /// </summary>
+    /// <param name="bytesPerFrame"></param>
+    virtual void SetAutoLoadByteBudget(uint32_t bytesPerFrame) = 0;
+
+    /// <summary>
+    ///   Gets the auto load time budget in microseconds.
+    /// </summary>
+    /// <returns></returns>
+    virtual uint32_t GetAutoLoadTimeBudget() = 0;
+
+    /// <summary>
+    ///   Sets how long the renderer hook can spend uploading images before rendering the frame, 0 to not limit it.
+    ///   The renderer measures its upload speed and only starts the uploads it expects to fit in the budget.
+    ///   At least one resource is loaded each frame, even if it is expected to take longer.
+    /// </summary>
+    /// <param name="microsecondsPerFrame"></param>
+    virtual void SetAutoLoadTimeBudget(uint32_t microsecondsPerFrame) = 0;
+
+    /// <summary>
+    ///   Gets the upload buffer size.
+    /// </summary>
+    /// <returns></returns>
+    virtual uint32_t GetUploadBufferSize() = 0;
+
+    /// <summary>
+    ///   Sets the size in bytes of the persistent buffer used by the renderers that stage the resources before copying them onto the GPU (Vulkan, OpenGL).
+    ///   A batch only takes the space it needs from it, a resource bigger than this buffer will use a temporary buffer instead.
+    ///   OpenGL splits it into 3 pixel buffer objects and uploads the bigger resources directly from their attached data.
+    ///   The buffer is recreated with the new size once the pending uploads are done.
+    /// </summary>
+    /// <param name="size"></param>
+    virtual void SetUploadBufferSize(uint32_t size) = 0;
+
+    /// <summary>
+    ///   Gets the texture memory usage of the renderer.
+    /// </summary>
+    /// <param name="stats"></param>
+    /// <returns>false if the renderer doesn't manage its texture memory itself.</returns>
+    virtual bool GetTextureMemoryStats(RendererTextureMemoryStats_t* stats) = 0;
+
+    /// <summary>
+    ///   Gets the texture memory budget in bytes.
+    /// </summary>
+    /// <returns></returns>
+    virtual uint64_t GetTextureMemoryBudget() = 0;
+
+    /// <summary>
+    ///   Sets how many bytes of resource textures the renderer hook keeps loaded, 0 to not limit it.
+    ///   When a new resource is loaded over the budget, the least recently used resources are unloaded until it fits.
+    ///   Only the resources not used in the current frame that still have their data attached are unloaded,
+    ///   they are loaded again the next time their resource id is requested. Atlased resources are never unloaded.
+    /// </summary>
+    /// <param name="bytes"></param>
+    virtual void SetTextureMemoryBudget(uint64_t bytes) = 0;
+
+    /// <summary>
+    ///   Gets the loaded resources size and how many were unloaded to stay under the texture memory budget.
+    /// </summary>
+    /// <param name="stats"></param>
+    virtual void GetResidencyStats(RendererResidencyStats_t* stats) = 0;
+
+    /// <summary>
+    ///   Gets if the resources with the same content share their texture.
+    /// </summary>
+    /// <returns></returns>
+    virtual bool GetResourceDeduplication() = 0;
+
+    /// <summary>
+    ///   Sets if the resources with the same content, size and format share their texture, it is uploaded only once.
+    ///   The content is hashed once, the first time the resource is loaded after its data was attached.
+    ///   A resource updated with RendererResource_t::UpdateRegion stops sharing its texture and loads its attached data again.
+    ///   Applies to the resources loaded after the call.
+    /// </summary>
+    /// <param name="enable"></param>
+    virtual void SetResourceDeduplication(bool enable) = 0;
+
+    /// <summary>
+    ///   Creates an image resource that can be setup and used later.
+    /// </summary>
+    /// <returns></returns>
+    virtual RendererResource_t* CreateResource() = 0;
+
+    /// <summary>
+    ///   Creates an image resource and attach the data to it.
+    /// </summary>
+    /// <param name="image_data">
+    ///   The RGBA buffer.
+    /// </param>
+    /// <param name="width">
+    ///   Your RGBA image width.
+    /// </param>
+    /// <param name="height">
+    ///   Your RGBA image height.
+    /// </param>
+    /// <returns></returns>
+    virtual RendererResource_t* CreateAndAttachResource(const void* image_data, uint32_t width, uint32_t height) = 0;
+
+    /// <summary>
+    ///   Creates an image resource that will be packed with the other small atlased resources into shared textures.
+    ///   All the resources of a page share the same resource id, use RendererResource_t::GetResourceUV to draw them.
+    ///   An attached image bigger than 256x256 will get its own texture, like a resource from CreateResource.
+    /// </summary>
+    /// <returns></returns>
+    virtual RendererResource_t* CreateAtlasedResource() = 0;
+
+    /// <summary>
+    ///   Creates an image resource from an encoded image (PNG, JPEG, BMP or TGA).
+    ///   The bytes are copied and decoded on a background thread, the decoded pixels are then loaded like an attached resource.
+    ///   Width() and Height() are 0 until the image is decoded, GetResourceId() returns 0 until it is loaded.
+    ///   HasAttachedResource() returns false if the image can't be decoded.
+    /// </summary>
+    /// <param name="data">The encoded image</param>
+    /// <param name="size">The encoded image size in bytes</param>
+    /// <returns></returns>
+    virtual RendererResource_t* CreateResourceFromEncoded(const void* data, size_t size) = 0;
+
+    /// <summary>
+    ///   Loads resources before they are drawn, so the overlay doesn't show them popping in the first time it is opened.
+    ///   Once the hook is ready, a few of them are loaded each frame, even while the overlay is hidden, limited by the auto load batch size.
+    ///   The resources with the highest priority are loaded first, then in the order they were given.
+    ///   Can be called from any thread and before the hook is started, a resource can be deleted before it is loaded.
+    ///   It never waits for the render thread, the resources given before the first overlay frame are kept until it starts.
+    /// </summary>
+    /// <param name="resources">The resources to load, the nullptr ones are skipped</param>
+    /// <param name="count">The resources count</param>
+    /// <param name="priority">The load priority</param>
+    virtual void Preload(RendererResource_t* const* resources, size_t count, int32_t priority = 0) = 0;
+
+    virtual void TakeScreenshot(ScreenshotType_t type) = 0;
+
+    /// <summary>
+    ///   Takes a screenshot scaled down on the GPU before it is read back, like a thumbnail. Only the scaled pixels are copied to the
+    ///   CPU, so the readback and the callback memory depend on the requested size and not on the back buffer size.
+    ///   The screenshot is never scaled up. The OpenGL, Vulkan and DirectX 9 renderers scale it with a linear filter, the other ones
+    ///   or a back buffer that can't be scaled send the full size, the callback Width and Height tell the size that was read.
+    /// </summary>
+    /// <param name="type">Take the screenshot before or after the overlay was drawn</param>
+    /// <param name="width">The screenshot width, 0 to compute it from the height and the back buffer aspect ratio</param>
+    /// <param name="height">The screenshot height, 0 to compute it from the width and the back buffer aspect ratio</param>
+    virtual void TakeScreenshot(ScreenshotType_t type, uint32_t width, uint32_t height) = 0;
+
+    /// <summary>
+    ///   Takes a screenshot of a rectangle of the back buffer, like an overlay window or a minimap. Only its pixels are copied to
+    ///   the CPU, the callback Width and Height are the rectangle size once it was clipped to the back buffer.
+    ///   A rectangle outside of the back buffer drops the screenshot, the callback is not called. A width or a height of 0 reads
+    ///   the whole back buffer.
+    /// </summary>
+    /// <param name="type">Take the screenshot before or after the overlay was drawn</param>
+    /// <param name="x">The rectangle left, in pixels from the back buffer left</param>
+    /// <param name="y">The rectangle top, in pixels from the back buffer top</param>
+    /// <param name="width">The rectangle width</param>
+    /// <param name="height">The rectangle height</param>
+    virtual void TakeScreenshot(ScreenshotType_t type, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+
+    /// <summary>
+    ///   Streams the frames to a callback at a target rate, until StopCapture is called.
+    ///   The frames are read back like the screenshots, up to ringDepth of them can be in flight. When they are all waiting for the
+    ///   GPU or for the renderer, the next frames are dropped instead of stalling the application.
+    ///   The callback is called on the render thread with the data valid only during the call, it must copy it and return quickly.
+    ///   A screenshot taken with TakeScreenshot is read first, the capture skips that frame.
+    /// </summary>
+    /// <param name="fps">The frames per second to capture, 0 captures every frame</param>
+    /// <param name="callback">Called with each captured frame, FrameIndex tells the frames that were dropped</param>
+    /// <param name="userParameter">Passed to the callback</param>
+    /// <param name="ringDepth">The captured frames that can be read back at the same time</param>
+    /// <param name="type">Capture the frames before or after the overlay was drawn</param>
+    /// <returns>false if the callback is nullptr or the type is ScreenshotType_t::None</returns>
+    virtual bool StartCapture(uint32_t fps, ScreenshotCallback_t callback, void* userParameter, uint32_t ringDepth = 3, ScreenshotType_t type = ScreenshotType_t::AfterOverlay) = 0;
+
+    /// <summary>
+    ///   Stops the capture, the frames still read back are dropped.
+    /// </summary>
+    virtual void StopCapture() = 0;
+
+    virtual bool IsCapturing() const = 0;
+};
+
+}
+
+inline InGameOverlay::RendererHookType_t operator&(InGameOverlay::RendererHookType_t l, InGameOverlay::RendererHookType_t r)
+{
+    return static_cast<InGameOverlay::RendererHookType_t>(static_cast<uint8_t>(l) & static_cast<uint8_t>(r));
+}
+
+inline InGameOverlay::RendererHookType_t operator|(InGameOverlay::RendererHookType_t l, InGameOverlay::RendererHookType_t r)
+{
+    return static_cast<InGameOverlay::RendererHookType_t>(static_cast<uint8_t>(l) | static_cast<uint8_t>(r));
 }
\ No newline at end of file
@@ -1,83 +1,184 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#pragma once
-
-namespace InGameOverlay {
-
-/// <summary>
-/// A renderer resource. It will be tied to the RendererHook that created it. Don't use it if you recycle the renderer hook.
-/// </summary>
-class RendererResource_t
-{
-protected:
-    virtual ~RendererResource_t() {}
-
-public:
-    /// <summary>
-    /// Deletes the resource.
-    /// </summary>
-    virtual void Delete() = 0;
-    /// <summary>
-    /// Checks if the resource is loaded.
-    /// </summary>
-    /// <returns>Is loaded or not</returns>
-    virtual bool IsLoaded() const = 0;
-    /// <summary>
-    /// Returns if the resource has an image attached to it so it can be auto loaded.
-    /// </summary>
-    /// <returns>Can be loaded</returns>
-    virtual bool HasAttachedResource() const = 0;
-    /// <summary>
-    /// Gets the resource id usable by ImGui::Image(). It will also trigger the autoload if set.
-    /// If autoload is in batch mode, the loading can be deferred by a few frames. (at least 1)
-    /// </summary>
-    /// <returns>The ImGui's image handle, 0 if it is not ready</returns>
-    virtual uint64_t GetResourceId() = 0;
-    /// <summary>
-    ///   Return the loaded or attached resource width.
-    /// </summary>
-    /// <returns></returns>
-    virtual uint32_t Width() const = 0;
-    /// <summary>
-    ///   Return the loaded or attached resource height.
-    /// </summary>
-    /// <returns></returns>
-    virtual uint32_t Height() const = 0;
-    /// <summary>
-    /// Attach a resource to this RendererResource, it will NOT OWN the data.
-    /// You are responsible to not outlive this object usage to the resource buffer.
-    /// Attaching a new resource will trigger the autoload if it is enabled, else, the old resource will still be used until you unload it.
-    /// </summary>
-    /// <param name="data">The resource raw data (in RGBA format)</param>
-    /// <param name="width">The resource width</param>
-    /// <param name="height">The resource height</param>
-    virtual void AttachResource(const void* data, uint32_t width, uint32_t height) = 0;
-    /// <summary>
-    /// Clears the attached resource. This will NOT delete the resource loaded onto the GPU. Call Unload for that purpose.
-    /// </summary>
-    virtual void ClearAttachedResource() = 0;
-    /// <summary>
-    /// Unloads the resource from the GPU. GetResourceId will return an invalid handle, IsLoaded will return false.
-    /// If auto loading is enabled, it will load again the resource if its not cleared.
-    /// </summary>
-    virtual void Unload(bool clearAttachedResource = true) = 0;
-};
-
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace InGameOverlay {
+
+/// <summary>
+/// The texture coordinates of a resource in the texture returned by RendererResource_t::GetResourceId().
+/// </summary>
+struct ResourceUV_t
+{
+    float U0;
+    float V0;
+    float U1;
+    float V1;
+};
+
+/// <summary>
+/// The pixel format of an attached resource, the rows are never padded.
+/// The block compressed formats are stored as rows of 4x4 pixel blocks.
+/// A renderer that can't sample a format gets the resource converted to R8G8B8A8 on the CPU.
+/// </summary>
+enum class ResourceFormat_t
+{
+    R8G8B8A8,
+    B8G8R8A8,
+    // 16 bits per pixel, red in the 5 high bits.
+    R5G6B5,
+    // Alpha only, the color is white. For masks and glyphs.
+    A8,
+    // Half floats, clamped to [0, 1] when converted.
+    R16G16B16A16_FLOAT,
+    // 8 bytes per block, 1 bit alpha.
+    BC1,
+    // 16 bytes per block.
+    BC3,
+    // 16 bytes per block.
+    BC7,
+    // 8 bytes per block, no alpha.
+    ETC2_RGB8,
+    // 16 bytes per block, EAC alpha.
+    ETC2_RGBA8,
+};
+
+/// <summary>
+/// Called when a renderer resource doesn't need the data it owns anymore.
+/// </summary>
+typedef void (*ResourceDataReleaseCallback_t)(void* data, void* userParameter);
+
+/// <summary>
+/// A renderer resource. It will be tied to the RendererHook that created it. Don't use it if you recycle the renderer hook.
+/// Delete, AttachResource and Unload can be called from any thread, outside of the render thread they are applied at the start of the next overlay frame.
+/// The other methods must be called from the render thread, in the overlay proc.
+/// </summary>
+class RendererResource_t
+{
+protected:
+    virtual ~RendererResource_t() {}
+
+public:
+    /// <summary>
+    /// Deletes the resource. From another thread than the render thread, it is deleted at the start of the next overlay frame.
+    /// </summary>
+    virtual void Delete() = 0;
+    /// <summary>
+    /// Checks if the resource is loaded.
+    /// </summary>
+    /// <returns>Is loaded or not</returns>
+    virtual bool IsLoaded() const = 0;
+    /// <summary>
+    /// Returns if the resource has an image attached to it so it can be auto loaded.
+    /// </summary>
+    /// <returns>Can be loaded</returns>
+    virtual bool HasAttachedResource() const = 0;
+    /// <summary>
+    /// Gets the resource id usable by ImGui::Image(). It will also trigger the autoload if set.
+    /// If autoload is in batch mode, the loading can be deferred by a few frames. (at least 1)
+    /// </summary>
+    /// <returns>The ImGui's image handle, 0 if it is not ready</returns>
+    virtual uint64_t GetResourceId() = 0;
+    /// <summary>
+    ///   Return the loaded or attached resource width.
+    /// </summary>
+    /// <returns></returns>
+    virtual uint32_t Width() const = 0;
+    /// <summary>
+    ///   Return the loaded or attached resource height.
+    /// </summary>
+    /// <returns></returns>
+    virtual uint32_t Height() const = 0;
+    /// <summary>
+    ///   Return the texture coordinates to use with the resource id, pass them to ImGui::Image() uv0 and uv1.
+    ///   A resource that is not atlased always returns the whole texture: (0, 0) (1, 1).
+    /// </summary>
+    /// <returns></returns>
+    virtual ResourceUV_t GetResourceUV() const = 0;
+    /// <summary>
+    /// Attach a resource to this RendererResource, it will NOT OWN the data.
+    /// You are responsible to not outlive this object usage to the resource buffer.
+    /// Attaching a new resource will trigger the autoload if it is enabled, else, the old resource will still be used until you unload it.
+    /// From another thread than the render thread, the data is attached at the start of the next overlay frame and must be valid until then.
+    /// </summary>
+    /// <param name="data">The resource raw data (in RGBA format)</param>
+    /// <param name="width">The resource width</param>
+    /// <param name="height">The resource height</param>
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height) = 0;
+    /// <summary>
+    /// Attach a resource to this RendererResource, it will OWN the data and call releaseCallback once it is not used anymore.
+    /// The data is kept while a pending load uses it, even if another resource is attached or the RendererResource is deleted.
+    /// The callback can be called from the renderer thread.
+    /// </summary>
+    /// <param name="data">The resource raw data (in RGBA format)</param>
+    /// <param name="width">The resource width</param>
+    /// <param name="height">The resource height</param>
+    /// <param name="releaseCallback">Frees the data, if nullptr the data is not owned, like the other AttachResource</param>
+    /// <param name="userParameter">Passed to releaseCallback</param>
+    /// <param name="releaseOnLoad">
+    ///   Releases the data as soon as the resource is loaded, the texture is still used.
+    ///   The resource can't be loaded again after an Unload or a renderer reset without attaching it again.
+    /// </param>
+    virtual void AttachResource(void* data, uint32_t width, uint32_t height, ResourceDataReleaseCallback_t releaseCallback, void* userParameter, bool releaseOnLoad) = 0;
+    /// <summary>
+    /// Attach a resource in another format than RGBA to this RendererResource, it will NOT OWN the data, like the RGBA AttachResource.
+    /// Only the R8G8B8A8 resources can be atlased or updated with UpdateRegion.
+    /// </summary>
+    /// <param name="data">The resource raw data</param>
+    /// <param name="width">The resource width</param>
+    /// <param name="height">The resource height</param>
+    /// <param name="format">The data format</param>
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height, ResourceFormat_t format) = 0;
+    /// <summary>
+    /// Updates a part of the loaded resource without uploading the whole image again, the pixels are copied.
+    /// Nothing is done if the resource is not loaded yet, keep the attached buffer up to date so a later load shows the same image.
+    /// The renderers that can't update a part of a texture will load the attached resource again.
+    /// </summary>
+    /// <param name="x">The region left position</param>
+    /// <param name="y">The region top position</param>
+    /// <param name="width">The region width</param>
+    /// <param name="height">The region height</param>
+    /// <param name="data">The region raw data (in RGBA format)</param>
+    /// <param name="pitch">The size in bytes of a data row, 0 if the rows are width * 4 bytes</param>
+    virtual void UpdateRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t pitch) = 0;
+    /// <summary>
+    /// Clears the attached resource. This will NOT delete the resource loaded onto the GPU. Call Unload for that purpose.
+    /// An owned data is released once no pending load uses it.
+    /// </summary>
+    virtual void ClearAttachedResource() = 0;
+    /// <summary>
+    /// Unloads the resource from the GPU. GetResourceId will return an invalid handle, IsLoaded will return false.
+    /// If auto loading is enabled, it will load again the resource if its not cleared.
+    /// From another thread than the render thread, it is unloaded at the start of the next overlay frame.
+    /// </summary>
+    virtual void Unload(bool clearAttachedResource = true) = 0;
+    /// <summary>
+    /// Generates the mipmaps of the resource when it is loaded, so a big image drawn smaller than its size doesn't alias.
+    /// Set it before the resource is loaded, it is used the next time the resource is loaded.
+    /// Only the OpenGL and Vulkan renderers generate them, atlased images and block compressed images loaded as they are never get mipmaps.
+    /// </summary>
+    /// <param name="generate">Generate the mipmaps</param>
+    virtual void SetGenerateMipmaps(bool generate) = 0;
+    /// <summary>
+    /// Returns true if the mipmaps are generated when the resource is loaded.
+    /// </summary>
+    virtual bool GetGenerateMipmaps() const = 0;
+};
+
 }
\ No newline at end of file
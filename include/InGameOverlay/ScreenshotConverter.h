@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "RendererHook.h"
+
+namespace InGameOverlay {
+
+enum class ScreenshotOutputFormat_t : uint8_t
+{
+    R8G8B8A8 = 0,
+    B8G8R8A8 = 1,
+};
+
+enum class ScreenshotConverterPath_t : uint8_t
+{
+    // The fastest path the CPU supports.
+    Auto   = 0,
+    Scalar = 1,
+    SSE2   = 2,
+    AVX2   = 3,
+    NEON   = 4,
+};
+
+/// <summary>
+///   Returns the bytes of a pixel of the format, 0 for ScreenshotDataFormat_t::Unknown.
+/// </summary>
+uint32_t GetScreenshotFormatPixelSize(ScreenshotDataFormat_t format);
+
+/// <summary>
+///   Returns the path ConvertScreenshotData uses for the format on this CPU when it is asked for path.
+///   A path the CPU doesn't support, or that has no kernel for the format, falls back to the next slower one, down to Scalar.
+/// </summary>
+ScreenshotConverterPath_t GetScreenshotConverterPath(ScreenshotDataFormat_t format, ScreenshotConverterPath_t path = ScreenshotConverterPath_t::Auto);
+
+/// <summary>
+///   Converts pixels of any ScreenshotDataFormat_t to 8 bits RGBA or BGRA.
+///   The D3D9 formats (X8R8G8B8, A2R10G10B10, R5G6B5, ...) are read as little endian words with their first channel in the high bits,
+///   the other ones (R8G8B8A8, R10G10B10A2, B5G5R5A1, ...) with their first channel in the low bits or first byte.
+///   The X formats give an opaque alpha, the float formats are clamped to [0, 1]. All the paths give the same bytes.
+///   data and output can be the same buffer when both pixel sizes are 4 bytes and the pitches are the same.
+/// </summary>
+/// <param name="format">The format of data</param>
+/// <param name="data">The pixels to convert</param>
+/// <param name="width">The pixels per row</param>
+/// <param name="height">The rows count</param>
+/// <param name="pitch">The bytes between two rows of data, 0 if they are packed</param>
+/// <param name="outputFormat">The format to write</param>
+/// <param name="output">Receives height rows of width * 4 bytes</param>
+/// <param name="outputPitch">The bytes between two rows of output, 0 if they are packed</param>
+/// <param name="path">Forces a conversion path, used to compare and benchmark them</param>
+/// <returns>false if the format is Unknown or a parameter is nullptr</returns>
+bool ConvertScreenshotData(ScreenshotDataFormat_t format, const void* data, uint32_t width, uint32_t height, uint32_t pitch,
+    ScreenshotOutputFormat_t outputFormat, void* output, uint32_t outputPitch,
+    ScreenshotConverterPath_t path = ScreenshotConverterPath_t::Auto);
+
+/// <summary>
+///   Converts the screenshot given to the screenshot callback, output must hold screenshot->Height rows of outputPitch bytes.
+/// </summary>
+bool ConvertScreenshot(ScreenshotCallbackParameter_t const* screenshot, ScreenshotOutputFormat_t outputFormat, void* output, uint32_t outputPitch = 0);
+
+}
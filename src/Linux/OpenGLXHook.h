@@ -32,6 +32,48 @@ class OpenGLXHook_t :
 private:
     static OpenGLXHook_t* _Instance;
 
+    constexpr static uint32_t UploadSlotCount = 3;
+
+    enum class UploadMode_t : uint8_t
+    {
+        // glTexImage2D from the client memory, used when the context has no sync objects.
+        Direct,
+        // Pixel buffer objects written with glMapBufferRange(GL_MAP_UNSYNCHRONIZED_BIT).
+        Unsynchronized,
+        // Pixel buffer objects persistently mapped (GL_ARB_buffer_storage).
+        Persistent,
+    };
+
+    // A pixel buffer object, it can be written again once the fence of its last upload is signaled.
+    struct UploadSlot_t
+    {
+        uint32_t Buffer = 0;
+        uint8_t* MappedData = nullptr;
+        struct __GLsync* Fence = nullptr;
+        std::vector<std::shared_ptr<RendererTexture_t>> Textures;
+    };
+
+    // A pixel pack buffer a screenshot is read in, it is mapped and sent once its fence is signaled.
+    struct ScreenshotSlot_t
+    {
+        uint32_t Buffer = 0;
+        size_t Size = 0;
+        struct __GLsync* Fence = nullptr;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        // Returned by _BeginScreenshot.
+        uint64_t ScreenshotId = 0;
+        // Set when the GPU flipped the rows top to bottom, the mapped buffer is sent as it is.
+        bool Flipped = false;
+    };
+
+    // Signaled once the GPU executed the overlay commands of the frame.
+    struct FrameFence_t
+    {
+        uint64_t Frame;
+        struct __GLsync* Fence;
+    };
+
     // Variables
     bool _Hooked;
     bool _X11Hooked;
@@ -39,9 +81,22 @@ private:
     OverlayHookState _HookState;
     Display *_Display;
     //GLXContext _Context;
-    std::set<std::shared_ptr<RendererTexture_t>> _ImageResources;
     std::vector<RendererTextureLoadParameter_t> _ImageResourcesToLoad;
-    std::vector<RendererTextureReleaseParameter_t> _ImageResourcesToRelease;
+    std::vector<RendererTextureUpdateParameter_t> _ImageResourcesToUpdate;
+    UploadMode_t _UploadMode;
+    bool _PersistentMappingSupported;
+    size_t _UploadSlotSize;
+    uint32_t _NextUploadSlot;
+    UploadSlot_t _UploadSlots[UploadSlotCount];
+    std::deque<FrameFence_t> _FrameFences;
+    // Ring of readback buffers, it grows to the capture ring depth.
+    std::vector<ScreenshotSlot_t> _ScreenshotSlots;
+    uint32_t _NextScreenshotSlot;
+    // The screenshot rectangle is blitted upside down in it before being read, scaled down to the screenshot size.
+    uint32_t _ScreenshotFramebuffer;
+    uint32_t _ScreenshotRenderbuffer;
+    uint32_t _ScreenshotRenderbufferWidth;
+    uint32_t _ScreenshotRenderbufferHeight;
     void* _ImGuiFontAtlas;
 
     // Functions
@@ -49,9 +104,16 @@ private:
 
     void _ResetRenderState(OverlayHookState state);
     void _PrepareForOverlay(Display* display, GLXDrawable drawable);
+    bool _CreateUploadSlots();
+    void _DestroyUploadSlots();
+    void _PollUploadSlots();
+    void _DestroyFrameFences();
     void _LoadResources();
     void _ReleaseResources();
     void _HandleScreenshot();
+    bool _ReadScreenshotAsync(int x, int y, int width, int height, uint32_t targetWidth, uint32_t targetHeight);
+    void _PollScreenshots();
+    void _DestroyScreenshotSlots();
 
     // Hook to render functions
     decltype(::glXSwapBuffers)* _GLXSwapBuffers;
@@ -72,9 +134,12 @@ public:
     virtual RendererHookType_t GetRendererHookType() const;
     void LoadFunctions(decltype(::glXSwapBuffers)* pfnglXSwapBuffers);
 
-    virtual std::weak_ptr<RendererTexture_t> AllocImageResource();
+    virtual RendererTextureHandle_t AllocImageResource();
+    virtual bool IsResourceFormatSupported(ResourceFormat_t format, uint32_t width, uint32_t height);
+
     virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter);
-    virtual void ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource);
+    virtual bool UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter);
+    virtual void ReleaseImageResource(RendererTextureHandle_t resource);
 };
 
 }// namespace InGameOverlay
\ No newline at end of file
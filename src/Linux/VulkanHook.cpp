@@ -27,6 +27,7 @@
 #include <backends/imgui_impl_vulkan.h>
 
 #include "../VulkanHelpers.h"
+#include "../RendererFormatInternal.h"
 
 #include <unistd.h>
 
@@ -34,10 +35,12 @@ namespace InGameOverlay {
 
 struct VulkanTexture_t : RendererTexture_t
 {
-    VkDeviceMemory VulkanImageMemory = VK_NULL_HANDLE;
+    VulkanHook_t::VulkanMemoryAllocation_t VulkanImageMemory;
     VulkanHook_t::VulkanDescriptorSet_t ImageDescriptorId;
     VkImage VulkanImage = VK_NULL_HANDLE;
     VkImageView VulkanImageView = VK_NULL_HANDLE;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
 };
 
 #define TRY_HOOK_FUNCTION_OR_FAIL(NAME) do { if (!HookFunc(std::make_pair<void**, void*>(&(void*&)_##NAME, (void*)&VulkanHook_t::_My##NAME))) { \
@@ -66,6 +69,33 @@ static inline uint32_t GetImageDescriptorPool(uint32_t descriptorId)
     return descriptorId / VulkanHook_t::MaxDescriptorCountPerPool;
 }
 
+static VkFormat ResourceFormatToVkFormat(ResourceFormat_t format)
+{
+    switch (format)
+    {
+        case ResourceFormat_t::R8G8B8A8          : return VK_FORMAT_R8G8B8A8_UNORM;
+        case ResourceFormat_t::B8G8R8A8          : return VK_FORMAT_B8G8R8A8_UNORM;
+        case ResourceFormat_t::R5G6B5            : return VK_FORMAT_R5G6B5_UNORM_PACK16;
+        case ResourceFormat_t::A8                : return VK_FORMAT_R8_UNORM;
+        case ResourceFormat_t::R16G16B16A16_FLOAT: return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case ResourceFormat_t::BC1               : return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case ResourceFormat_t::BC3               : return VK_FORMAT_BC3_UNORM_BLOCK;
+        case ResourceFormat_t::BC7               : return VK_FORMAT_BC7_UNORM_BLOCK;
+        case ResourceFormat_t::ETC2_RGB8         : return VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+        case ResourceFormat_t::ETC2_RGBA8        : return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+        default                                  : return VK_FORMAT_UNDEFINED;
+    }
+}
+
+static VkComponentMapping ResourceFormatToVkComponents(ResourceFormat_t format)
+{
+    // The alpha masks are sampled as a white image with the red channel as alpha.
+    if (format == ResourceFormat_t::A8)
+        return { VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_R };
+
+    return { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+}
+
 static InGameOverlay::ScreenshotDataFormat_t RendererFormatToScreenshotFormat(VkFormat format)
 {
     switch (format)
@@ -84,6 +114,19 @@ static InGameOverlay::ScreenshotDataFormat_t RendererFormatToScreenshotFormat(Vk
     }
 }
 
+static uint32_t VkFormatPixelSize(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_B5G6R5_UNORM_PACK16  :
+        case VK_FORMAT_B5G5R5A1_UNORM_PACK16: return 2;
+        case VK_FORMAT_R16G16B16A16_SFLOAT  :
+        case VK_FORMAT_R16G16B16A16_UNORM   : return 8;
+        case VK_FORMAT_R32G32B32A32_SFLOAT  : return 16;
+        default:                              return 4;
+    }
+}
+
 bool VulkanHook_t::StartHook(std::function<void()> keyCombinationCallback, ToggleKey toggleKeys[], int toggleKeysCount, /*ImFontAtlas* */ void* imguiFontAtlas)
 {
     if (!_Hooked)
@@ -147,7 +190,6 @@ bool VulkanHook_t::_AllocDescriptorPool()
 
     VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
     descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
     descriptorPoolCreateInfo.maxSets = MaxDescriptorCountPerPool;
     descriptorPoolCreateInfo.poolSizeCount = (uint32_t)(sizeof(poolSizes) / sizeof(poolSizes[0]));
     descriptorPoolCreateInfo.pPoolSizes = poolSizes;
@@ -174,9 +216,10 @@ VulkanHook_t::VulkanDescriptorSet_t VulkanHook_t::_GetFreeDescriptorSetFromPool(
     alloc_info.descriptorPool = descriptorsPool.DescriptorPool;
     alloc_info.descriptorSetCount = 1;
     alloc_info.pSetLayouts = &_VulkanImageDescriptorSetLayout;
-    auto result = _vkAllocateDescriptorSets(_VulkanDevice, &alloc_info, &vulkanDescriptorSet);
+    if (_vkAllocateDescriptorSets(_VulkanDevice, &alloc_info, &vulkanDescriptorSet) != VkResult::VK_SUCCESS)
+        return descriptorSet;
     
-    descriptorSet.DescriptorPoolId = MakeImageDescriptorId(poolIndex, descriptorsPool.UsedDescriptors++);
+    descriptorSet.DescriptorPoolId = MakeImageDescriptorId(poolIndex, descriptorsPool.AllocatedDescriptors++);
     descriptorSet.DescriptorSet = vulkanDescriptorSet;
     
     return descriptorSet;
@@ -184,13 +227,15 @@ VulkanHook_t::VulkanDescriptorSet_t VulkanHook_t::_GetFreeDescriptorSetFromPool(
 
 VulkanHook_t::VulkanDescriptorSet_t VulkanHook_t::_GetFreeDescriptorSet()
 {
-    for (uint32_t poolIndex = 0; poolIndex < _DescriptorsPools.size(); ++poolIndex)
+    if (!_FreeDescriptorSets.empty())
     {
-        if (_DescriptorsPools[poolIndex].UsedDescriptors < MaxDescriptorCountPerPool)
-            return _GetFreeDescriptorSetFromPool(poolIndex);
+        auto descriptorSet = _FreeDescriptorSets.back();
+        _FreeDescriptorSets.pop_back();
+        return descriptorSet;
     }
 
-    if (!_AllocDescriptorPool())
+    // The pools are filled one after the other, only the last one can have sets left.
+    if ((_DescriptorsPools.empty() || _DescriptorsPools.back().AllocatedDescriptors >= MaxDescriptorCountPerPool) && !_AllocDescriptorPool())
         return {};
 
     return _GetFreeDescriptorSetFromPool(_DescriptorsPools.size() - 1);
@@ -198,10 +243,12 @@ VulkanHook_t::VulkanDescriptorSet_t VulkanHook_t::_GetFreeDescriptorSet()
 
 void VulkanHook_t::_ReleaseDescriptor(VulkanDescriptorSet_t descriptorSet)
 {
-    auto& pool = _DescriptorsPools[GetImageDescriptorPool(descriptorSet.DescriptorPoolId)];
+    // The pools were destroyed with their sets.
+    if (GetImageDescriptorPool(descriptorSet.DescriptorPoolId) >= _DescriptorsPools.size())
+        return;
 
-    _vkFreeDescriptorSets(_VulkanDevice, pool.DescriptorPool, 1, &descriptorSet.DescriptorSet);
-    --pool.UsedDescriptors;
+    // The set is written again by _CreateImageTexture when it is reused, no need to free it.
+    _FreeDescriptorSets.emplace_back(descriptorSet);
 }
 
 void VulkanHook_t::_DestroyDescriptorPools()
@@ -210,6 +257,7 @@ void VulkanHook_t::_DestroyDescriptorPools()
         _vkDestroyDescriptorPool(_VulkanDevice, pool.DescriptorPool, _VulkanAllocationCallbacks);
 
     _DescriptorsPools.clear();
+    _FreeDescriptorSets.clear();
 }
 
 void VulkanHook_t::_CreateImageTexture(VkDescriptorSet descriptorSet, VkImageView imageView, VkImageLayout imageLayout)
@@ -340,6 +388,8 @@ void VulkanHook_t::_DestroyRenderTargets()
 {
     for (auto& frame : _OverlayFrames)
     {
+        _DestroyScreenshotBuffer(frame);
+
         if (frame.Fence)
             _vkDestroyFence(_VulkanDevice, frame.Fence, _VulkanAllocationCallbacks);
 
@@ -362,6 +412,9 @@ void VulkanHook_t::_DestroyRenderTargets()
             _vkDestroySemaphore(_VulkanDevice, frame.RenderCompleteSemaphore, _VulkanAllocationCallbacks);
     }
     _OverlayFrames.clear();
+
+    // Created with the swapchain format.
+    _DestroyScreenshotScaledImage();
 }
 
 void VulkanHook_t::_ResetRenderState(OverlayHookState state)
@@ -379,7 +432,7 @@ void VulkanHook_t::_ResetRenderState(OverlayHookState state)
             X11Hook_t::Inst()->ResetRenderState(state);
             ImGui::DestroyContext();
 
-            _ImageResources.clear();
+            _ClearTextures();
 
             _FreeVulkanRessources();
 
@@ -437,14 +490,12 @@ bool VulkanHook_t::_CreateVulkanInstance()
     LOAD_VULKAN_FUNCTION(vkDeviceWaitIdle);
 
     LOAD_VULKAN_FUNCTION(vkQueueSubmit);
-    LOAD_VULKAN_FUNCTION(vkQueueWaitIdle);
     LOAD_VULKAN_FUNCTION(vkGetDeviceQueue);
     LOAD_VULKAN_FUNCTION(vkCreateRenderPass);
     LOAD_VULKAN_FUNCTION(vkCmdBeginRenderPass);
     LOAD_VULKAN_FUNCTION(vkCmdEndRenderPass);
     LOAD_VULKAN_FUNCTION(vkDestroyRenderPass);
-    LOAD_VULKAN_FUNCTION(vkCmdCopyImage);
-    LOAD_VULKAN_FUNCTION(vkGetImageSubresourceLayout);
+    LOAD_VULKAN_FUNCTION(vkCmdCopyImageToBuffer);
     LOAD_VULKAN_FUNCTION(vkCreateSemaphore);
     LOAD_VULKAN_FUNCTION(vkDestroySemaphore);
     LOAD_VULKAN_FUNCTION(vkCreateBuffer);
@@ -454,6 +505,7 @@ bool VulkanHook_t::_CreateVulkanInstance()
     LOAD_VULKAN_FUNCTION(vkFlushMappedMemoryRanges);
     LOAD_VULKAN_FUNCTION(vkBindBufferMemory);
     LOAD_VULKAN_FUNCTION(vkCmdCopyBufferToImage);
+    LOAD_VULKAN_FUNCTION(vkCmdBlitImage);
     LOAD_VULKAN_FUNCTION(vkBindImageMemory);
     LOAD_VULKAN_FUNCTION(vkCreateCommandPool);
     LOAD_VULKAN_FUNCTION(vkResetCommandPool);
@@ -476,6 +528,7 @@ bool VulkanHook_t::_CreateVulkanInstance()
     LOAD_VULKAN_FUNCTION(vkDestroyFramebuffer);
     LOAD_VULKAN_FUNCTION(vkCreateFence);
     LOAD_VULKAN_FUNCTION(vkWaitForFences);
+    LOAD_VULKAN_FUNCTION(vkGetFenceStatus);
     LOAD_VULKAN_FUNCTION(vkResetFences);
     LOAD_VULKAN_FUNCTION(vkDestroyFence);
     LOAD_VULKAN_FUNCTION(vkCreateDescriptorPool);
@@ -484,10 +537,10 @@ bool VulkanHook_t::_CreateVulkanInstance()
     LOAD_VULKAN_FUNCTION(vkDestroyDescriptorSetLayout);
     LOAD_VULKAN_FUNCTION(vkAllocateDescriptorSets);
     LOAD_VULKAN_FUNCTION(vkUpdateDescriptorSets);
-    LOAD_VULKAN_FUNCTION(vkFreeDescriptorSets);
     LOAD_VULKAN_FUNCTION(vkGetBufferMemoryRequirements);
     LOAD_VULKAN_FUNCTION(vkGetImageMemoryRequirements);
     LOAD_VULKAN_FUNCTION(vkGetPhysicalDeviceMemoryProperties);
+    LOAD_VULKAN_FUNCTION(vkGetPhysicalDeviceFormatProperties);
     LOAD_VULKAN_FUNCTION(vkEnumerateDeviceExtensionProperties);
     LOAD_VULKAN_FUNCTION(vkEnumeratePhysicalDevices);
     LOAD_VULKAN_FUNCTION(vkGetPhysicalDeviceSurfaceFormatsKHR);
@@ -583,27 +636,6 @@ bool VulkanHook_t::_GetPhysicalDevice()
     return true;
 }
 
-bool VulkanHook_t::_CreateImageFence()
-{
-    if (_VulkanImageFence != VK_NULL_HANDLE)
-        return true;
-
-    VkFenceCreateInfo fenceInfo{};
-    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceInfo.flags = 0;
-
-    return _vkCreateFence(_VulkanDevice, &fenceInfo, _VulkanAllocationCallbacks, &_VulkanImageFence) == VkResult::VK_SUCCESS;
-}
-
-void VulkanHook_t::_DestroyImageFence()
-{
-    if (_VulkanImageFence != VK_NULL_HANDLE)
-    {
-        _vkDestroyFence(_VulkanDevice, _VulkanImageFence, _VulkanAllocationCallbacks);
-        _VulkanImageFence = VK_NULL_HANDLE;
-    }
-}
-
 bool VulkanHook_t::_CreateImageSampler()
 {
     if (_VulkanImageSampler != VK_NULL_HANDLE)
@@ -664,7 +696,7 @@ bool VulkanHook_t::_CreateImageCommandPool()
 
     VkCommandPoolCreateInfo info = {};
     info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    info.flags = 0;
+    info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
     info.queueFamilyIndex = _VulkanQueueFamily;
     return _vkCreateCommandPool(_VulkanDevice, &info, _VulkanAllocationCallbacks, &_VulkanImageCommandPool) == VkResult::VK_SUCCESS;
 }
@@ -678,32 +710,331 @@ void VulkanHook_t::_DestroyImageCommandPool()
     }
 }
 
-bool VulkanHook_t::_CreateImageCommandBuffer()
+bool VulkanHook_t::_AcquireUploadBatch(VulkanUploadBatch_t& uploadBatch)
 {
-    if (_VulkanImageCommandBuffer != VK_NULL_HANDLE)
+    if (!_FreeUploadBatches.empty())
+    {
+        uploadBatch = std::move(_FreeUploadBatches.back());
+        _FreeUploadBatches.pop_back();
         return true;
+    }
 
-    VkCommandBufferAllocateInfo info = {};
-    info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    info.commandPool = _VulkanImageCommandPool;
-    info.commandBufferCount = 1;
-    return _vkAllocateCommandBuffers(_VulkanDevice, &info, &_VulkanImageCommandBuffer) == VkResult::VK_SUCCESS;
+    VkCommandBufferAllocateInfo commandBufferInfo = {};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferInfo.commandPool = _VulkanImageCommandPool;
+    commandBufferInfo.commandBufferCount = 1;
+    if (_vkAllocateCommandBuffers(_VulkanDevice, &commandBufferInfo, &uploadBatch.CommandBuffer) != VkResult::VK_SUCCESS)
+        return false;
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = 0;
+    if (_vkCreateFence(_VulkanDevice, &fenceInfo, _VulkanAllocationCallbacks, &uploadBatch.Fence) != VkResult::VK_SUCCESS)
+    {
+        _vkFreeCommandBuffers(_VulkanDevice, _VulkanImageCommandPool, 1, &uploadBatch.CommandBuffer);
+        uploadBatch.CommandBuffer = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
 }
 
-void VulkanHook_t::_DestroyImageCommandBuffer()
+void VulkanHook_t::_PollUploadBatches(bool wait)
 {
-    if (_VulkanImageCommandBuffer != VK_NULL_HANDLE)
+    size_t completedCount = 0;
+
+    // Batches are retired in submission order, the staging ring tail can only move forward.
+    for (auto& uploadBatch : _PendingUploadBatches)
     {
-        _vkFreeCommandBuffers(_VulkanDevice, _VulkanImageCommandPool, 1, &_VulkanImageCommandBuffer);
-        _VulkanImageCommandBuffer = VK_NULL_HANDLE;
+        if (wait)
+            _vkWaitForFences(_VulkanDevice, 1, &uploadBatch.Fence, VK_TRUE, UINT64_MAX);
+        else if (_vkGetFenceStatus(_VulkanDevice, uploadBatch.Fence) != VkResult::VK_SUCCESS)
+            break;
+
+        for (auto& texture : uploadBatch.Textures)
+        {
+            auto textureSlot = GetTextureSlot(texture->Handle);
+            if (textureSlot != nullptr && textureSlot->LoadStatus == RendererTextureStatus_e::Loading)
+                _SetTextureLoadStatus(texture->Handle, RendererTextureStatus_e::Loaded);
+        }
+
+        for (auto& uploadBuffer : uploadBatch.UploadBuffers)
+            _DestroyUploadBuffer(uploadBuffer);
+
+        _RetireStagingRange(uploadBatch.StagingHead);
+        _vkResetFences(_VulkanDevice, 1, &uploadBatch.Fence);
+
+        uploadBatch.Textures.clear();
+        uploadBatch.UploadBuffers.clear();
+        _FreeUploadBatches.emplace_back(std::move(uploadBatch));
+        ++completedCount;
     }
+
+    _PendingUploadBatches.erase(_PendingUploadBatches.begin(), _PendingUploadBatches.begin() + completedCount);
 }
 
-bool VulkanHook_t::_CreateImageDevices()
+void VulkanHook_t::_DestroyUploadBatches()
+{
+    _PollUploadBatches(true);
+
+    for (auto& uploadBatch : _FreeUploadBatches)
+    {
+        _vkDestroyFence(_VulkanDevice, uploadBatch.Fence, _VulkanAllocationCallbacks);
+        _vkFreeCommandBuffers(_VulkanDevice, _VulkanImageCommandPool, 1, &uploadBatch.CommandBuffer);
+    }
+    _FreeUploadBatches.clear();
+}
+
+bool VulkanHook_t::_CreateUploadBuffer(VkDeviceSize size, VulkanUploadBuffer_t& uploadBuffer)
+{
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    if (_CheckVkResult(_vkCreateBuffer(_VulkanDevice, &bufferInfo, _VulkanAllocationCallbacks, &uploadBuffer.Buffer)) != VkResult::VK_SUCCESS)
+        return false;
+
+    VkMemoryRequirements req;
+    _vkGetBufferMemoryRequirements(_VulkanDevice, uploadBuffer.Buffer, &req);
+
+    VkMemoryAllocateInfo alloc{};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = req.size;
+    alloc.memoryTypeIndex = _GetVulkanMemoryType(
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        req.memoryTypeBits);
+
+    if (_CheckVkResult(_vkAllocateMemory(_VulkanDevice, &alloc, _VulkanAllocationCallbacks, &uploadBuffer.Memory)) != VkResult::VK_SUCCESS ||
+        _CheckVkResult(_vkBindBufferMemory(_VulkanDevice, uploadBuffer.Buffer, uploadBuffer.Memory, 0)) != VkResult::VK_SUCCESS ||
+        _CheckVkResult(_vkMapMemory(_VulkanDevice, uploadBuffer.Memory, 0, size, 0, (void**)&uploadBuffer.Data)) != VkResult::VK_SUCCESS)
+    {
+        _DestroyUploadBuffer(uploadBuffer);
+        return false;
+    }
+
+    uploadBuffer.Size = size;
+    return true;
+}
+
+void VulkanHook_t::_DestroyUploadBuffer(VulkanUploadBuffer_t& uploadBuffer)
+{
+    if (uploadBuffer.Data != nullptr)
+        _vkUnmapMemory(_VulkanDevice, uploadBuffer.Memory);
+
+    if (uploadBuffer.Buffer != VK_NULL_HANDLE)
+        _vkDestroyBuffer(_VulkanDevice, uploadBuffer.Buffer, _VulkanAllocationCallbacks);
+
+    if (uploadBuffer.Memory != VK_NULL_HANDLE)
+        _vkFreeMemory(_VulkanDevice, uploadBuffer.Memory, _VulkanAllocationCallbacks);
+
+    uploadBuffer = VulkanUploadBuffer_t{};
+}
+
+bool VulkanHook_t::_CreateStagingRing()
+{
+    const VkDeviceSize ringSize = (VkDeviceSize(_UploadBufferSize) + VulkanStagingRing_t::Alignment - 1) & ~(VulkanStagingRing_t::Alignment - 1);
+
+    if (_StagingRing.UploadBuffer.Buffer != VK_NULL_HANDLE)
+    {
+        // Only resize the ring when nothing is in flight.
+        if (_StagingRing.UploadBuffer.Size == ringSize || _StagingRing.Head != _StagingRing.Tail)
+            return true;
+
+        _DestroyStagingRing();
+    }
+
+    if (ringSize == 0)
+        return false;
+
+    return _CreateUploadBuffer(ringSize, _StagingRing.UploadBuffer);
+}
+
+void VulkanHook_t::_DestroyStagingRing()
+{
+    _DestroyUploadBuffer(_StagingRing.UploadBuffer);
+    _StagingRing.Head = 0;
+    _StagingRing.Tail = 0;
+}
+
+VkDeviceSize VulkanHook_t::_AllocStagingRange(VkDeviceSize size)
+{
+    const VkDeviceSize ringSize = _StagingRing.UploadBuffer.Size;
+    VkDeviceSize head = (_StagingRing.Head + VulkanStagingRing_t::Alignment - 1) & ~(VulkanStagingRing_t::Alignment - 1);
+    VkDeviceSize offset = head % ringSize;
+
+    // A range is never split, wrap to the ring start when it doesn't fit at the end.
+    if (offset + size > ringSize)
+    {
+        head += ringSize - offset;
+        offset = 0;
+    }
+
+    // Nothing is in flight, the whole ring is free whatever the head position.
+    if (_StagingRing.Head == _StagingRing.Tail)
+        _StagingRing.Tail = head;
+
+    if (head + size - _StagingRing.Tail > ringSize)
+        return VulkanStagingRing_t::InvalidOffset;
+
+    _StagingRing.Head = head + size;
+    return offset;
+}
+
+void VulkanHook_t::_RetireStagingRange(VkDeviceSize head)
 {
-    if (!_CreateImageFence())
+    // The tail may have been moved past the batch head while the ring was idle.
+    _StagingRing.Tail = std::max(_StagingRing.Tail, head);
+}
+
+bool VulkanHook_t::_AllocateImageMemory(VkMemoryRequirements const& requirements, VulkanMemoryAllocation_t& allocation)
+{
+    const uint32_t memoryTypeIndex = _GetVulkanMemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, requirements.memoryTypeBits);
+    if (memoryTypeIndex == 0xFFFFFFFF)
         return false;
 
+    if (_BufferImageGranularity == 0)
+    {
+        VkPhysicalDeviceProperties properties;
+        _vkGetPhysicalDeviceProperties(_VulkanPhysicalDevice, &properties);
+        _BufferImageGranularity = properties.limits.bufferImageGranularity;
+    }
+
+    // Only optimal tiling images live in the blocks, still keep them on a granularity boundary so a linear resource could be added later.
+    VkDeviceSize alignment = requirements.alignment > _BufferImageGranularity ? requirements.alignment : _BufferImageGranularity;
+    if (alignment == 0)
+        alignment = 1;
+
+    const bool dedicated = requirements.size > ImageMemoryBlockSize / 2;
+
+    if (!dedicated)
+    {
+        for (auto& block : _ImageMemoryBlocks)
+        {
+            if (block->Dedicated || block->MemoryTypeIndex != memoryTypeIndex)
+                continue;
+
+            for (size_t i = 0; i < block->FreeRanges.size(); ++i)
+            {
+                auto range = block->FreeRanges[i];
+                const VkDeviceSize offset = (range.Offset + alignment - 1) / alignment * alignment;
+                const VkDeviceSize end = offset + requirements.size;
+                if (end > range.Offset + range.Size)
+                    continue;
+
+                block->FreeRanges.erase(block->FreeRanges.begin() + i);
+                if (end < range.Offset + range.Size)
+                    block->FreeRanges.insert(block->FreeRanges.begin() + i, VulkanMemoryBlock_t::FreeRange_t{ end, range.Offset + range.Size - end });
+                if (offset > range.Offset)
+                    block->FreeRanges.insert(block->FreeRanges.begin() + i, VulkanMemoryBlock_t::FreeRange_t{ range.Offset, offset - range.Offset });
+
+                block->UsedSize += requirements.size;
+                ++block->AllocationCount;
+
+                allocation.Block = block.get();
+                allocation.Offset = offset;
+                allocation.Size = requirements.size;
+                return true;
+            }
+        }
+    }
+
+    auto block = std::make_unique<VulkanMemoryBlock_t>();
+
+    VkMemoryAllocateInfo alloc{};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = dedicated ? requirements.size : ImageMemoryBlockSize;
+    alloc.memoryTypeIndex = memoryTypeIndex;
+
+    if (_CheckVkResult(_vkAllocateMemory(_VulkanDevice, &alloc, _VulkanAllocationCallbacks, &block->Memory)) != VkResult::VK_SUCCESS)
+        return false;
+
+    block->MemoryTypeIndex = memoryTypeIndex;
+    block->Size = alloc.allocationSize;
+    block->UsedSize = requirements.size;
+    block->AllocationCount = 1;
+    block->Dedicated = dedicated;
+    if (!dedicated)
+        block->FreeRanges.emplace_back(VulkanMemoryBlock_t::FreeRange_t{ requirements.size, block->Size - requirements.size });
+
+    allocation.Block = block.get();
+    allocation.Offset = 0;
+    allocation.Size = requirements.size;
+
+    _ImageMemoryBlocks.emplace_back(std::move(block));
+    return true;
+}
+
+void VulkanHook_t::_FreeImageMemory(VulkanMemoryAllocation_t& allocation)
+{
+    auto block = allocation.Block;
+    if (block == nullptr)
+        return;
+
+    block->UsedSize -= allocation.Size;
+    --block->AllocationCount;
+
+    if (!block->Dedicated)
+    {
+        auto it = std::lower_bound(block->FreeRanges.begin(), block->FreeRanges.end(), allocation.Offset, [](VulkanMemoryBlock_t::FreeRange_t const& range, VkDeviceSize offset)
+        {
+            return range.Offset < offset;
+        });
+
+        it = block->FreeRanges.insert(it, VulkanMemoryBlock_t::FreeRange_t{ allocation.Offset, allocation.Size });
+
+        // Merge with the next and previous free ranges.
+        auto next = it + 1;
+        if (next != block->FreeRanges.end() && it->Offset + it->Size == next->Offset)
+        {
+            it->Size += next->Size;
+            it = block->FreeRanges.erase(next) - 1;
+        }
+        if (it != block->FreeRanges.begin())
+        {
+            auto previous = it - 1;
+            if (previous->Offset + previous->Size == it->Offset)
+            {
+                previous->Size += it->Size;
+                block->FreeRanges.erase(it);
+            }
+        }
+    }
+
+    allocation = VulkanMemoryAllocation_t{};
+
+    if (block->AllocationCount != 0)
+        return;
+
+    // Keep one empty block per memory type to not allocate again on the next texture.
+    if (!block->Dedicated)
+    {
+        auto otherEmptyBlock = std::find_if(_ImageMemoryBlocks.begin(), _ImageMemoryBlocks.end(), [block](std::unique_ptr<VulkanMemoryBlock_t> const& other)
+        {
+            return other.get() != block && !other->Dedicated && other->MemoryTypeIndex == block->MemoryTypeIndex && other->AllocationCount == 0;
+        });
+
+        if (otherEmptyBlock == _ImageMemoryBlocks.end())
+            return;
+    }
+
+    _vkFreeMemory(_VulkanDevice, block->Memory, _VulkanAllocationCallbacks);
+    _ImageMemoryBlocks.erase(std::find_if(_ImageMemoryBlocks.begin(), _ImageMemoryBlocks.end(), [block](std::unique_ptr<VulkanMemoryBlock_t> const& other)
+    {
+        return other.get() == block;
+    }));
+}
+
+void VulkanHook_t::_DestroyImageMemoryBlocks()
+{
+    for (auto& block : _ImageMemoryBlocks)
+        _vkFreeMemory(_VulkanDevice, block->Memory, _VulkanAllocationCallbacks);
+
+    _ImageMemoryBlocks.clear();
+}
+
+bool VulkanHook_t::_CreateImageDevices()
+{
     if (!_CreateImageSampler())
         return false;
 
@@ -713,19 +1044,19 @@ bool VulkanHook_t::_CreateImageDevices()
     if (!_CreateImageCommandPool())
         return false;
 
-    if (!_CreateImageCommandBuffer())
-        return false;
-
     return true;
 }
 
 void VulkanHook_t::_DestroyImageDevices()
 {
-    _DestroyImageCommandBuffer();
+    // Textures waiting for their release hold memory from the blocks.
+    _ClearRetiredTextures();
+    _DestroyUploadBatches();
+    _DestroyImageMemoryBlocks();
+    _DestroyStagingRing();
     _DestroyImageCommandPool();
     _DestroyImageDescriptorSetLayout();
     _DestroyImageSampler();
-    _DestroyImageFence();
 }
 
 bool VulkanHook_t::_CreateRenderPass()
@@ -867,7 +1198,10 @@ void VulkanHook_t::_PrepareForOverlay(VkQueue queue, const VkPresentInfoKHR* pPr
 
         {
             _vkWaitForFences(_VulkanDevice, 1, &frame.Fence, VK_TRUE, ~0ull);
+            // Sends the screenshots of the completed frames, including this one, before its fence is reset.
+            _PollScreenshots();
             _vkResetFences(_VulkanDevice, 1, &frame.Fence);
+            _SetCompletedFrame(frame.SubmittedFrame);
         }
         {
             _vkResetCommandBuffer(frame.CommandBuffer, 0);
@@ -878,16 +1212,6 @@ void VulkanHook_t::_PrepareForOverlay(VkQueue queue, const VkPresentInfoKHR* pPr
 
             _vkBeginCommandBuffer(frame.CommandBuffer, &info);
         }
-        {
-            VkRenderPassBeginInfo info = { };
-            info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-            info.renderPass = _VulkanRenderPass;
-            info.framebuffer = frame.Framebuffer;
-            info.renderArea.extent.width = ImGui::GetIO().DisplaySize.x;
-            info.renderArea.extent.height = ImGui::GetIO().DisplaySize.y;
-
-            _vkCmdBeginRenderPass(frame.CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
-        }
 
         if (ImGui_ImplVulkan_NewFrame() && !X11Hook_t::Inst()->PrepareForOverlay((Window)_Window))
             return;
@@ -905,19 +1229,37 @@ void VulkanHook_t::_PrepareForOverlay(VkQueue queue, const VkPresentInfoKHR* pPr
         ++_CurrentFrame;
         ImGui::NewFrame();
 
+        _ProcessResourceCommands();
         OverlayProc();
+        _ProcessPreloads();
 
         _LoadResources();
         _ReleaseResources();
 
         ImGui::Render();
 
+        {
+            VkRenderPassBeginInfo info = { };
+            info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            info.renderPass = _VulkanRenderPass;
+            info.framebuffer = frame.Framebuffer;
+            info.renderArea.extent.width = ImGui::GetIO().DisplaySize.x;
+            info.renderArea.extent.height = ImGui::GetIO().DisplaySize.y;
+
+            _vkCmdBeginRenderPass(frame.CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
+        }
+
         // Record dear imgui primitives into command buffer
         ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), frame.CommandBuffer);
 
-        // Submit command buffer
         _vkCmdEndRenderPass(frame.CommandBuffer);
+
+        if (screenshotType == ScreenshotType_t::AfterOverlay)
+            _HandleScreenshot(frame);
+
+        // Submit command buffer
         _vkEndCommandBuffer(frame.CommandBuffer);
+        frame.SubmittedFrame = _CurrentFrame;
 
         uint32_t waitSemaphoresCount = i == 0 ? pPresentInfo->waitSemaphoreCount : 0;
         if (waitSemaphoresCount == 0 && !queueSupportsGraphic)
@@ -952,7 +1294,7 @@ void VulkanHook_t::_PrepareForOverlay(VkQueue queue, const VkPresentInfoKHR* pPr
         }
         else
         {
-            std::vector<VkPipelineStageFlags> stages_wait(waitSemaphoresCount, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+            std::vector<VkPipelineStageFlags> stages_wait(waitSemaphoresCount, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
 
             VkSubmitInfo info = { };
             info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -971,141 +1313,256 @@ void VulkanHook_t::_PrepareForOverlay(VkQueue queue, const VkPresentInfoKHR* pPr
 
             _vkQueueSubmit(_VulkanQueue, 1, &info, frame.Fence);
         }
+    }
+}
 
-        if (screenshotType == ScreenshotType_t::AfterOverlay)
-            _HandleScreenshot(frame);
+VulkanHook_t::StageResult_t VulkanHook_t::_StageUpload(const void* data, VkDeviceSize size, std::vector<VulkanUploadBuffer_t>& dedicatedBuffers, VkBuffer& buffer, VkDeviceSize& offset)
+{
+    if (size > _StagingRing.UploadBuffer.Size)
+    {
+        // Too big for the ring, stage it in its own buffer.
+        VulkanUploadBuffer_t uploadBuffer;
+        if (!_CreateUploadBuffer(size, uploadBuffer))
+            return StageResult_t::Failed;
+
+        memcpy(uploadBuffer.Data, data, size);
+        buffer = uploadBuffer.Buffer;
+        offset = 0;
+        dedicatedBuffers.emplace_back(uploadBuffer);
+        return StageResult_t::Staged;
+    }
+
+    offset = _AllocStagingRange(size);
+    if (offset == VulkanStagingRing_t::InvalidOffset)
+        return StageResult_t::RingFull;
+
+    memcpy(_StagingRing.UploadBuffer.Data + offset, data, size);
+    buffer = _StagingRing.UploadBuffer.Buffer;
+    return StageResult_t::Staged;
+}
+
+void VulkanHook_t::_GenerateMipmaps(VkCommandBuffer commandBuffer, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels)
+{
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+
+    int32_t mipWidth = static_cast<int32_t>(width);
+    int32_t mipHeight = static_cast<int32_t>(height);
+
+    // Every level is in the transfer destination layout, each one is blitted from the previous one.
+    for (uint32_t i = 1; i < mipLevels; ++i)
+    {
+        barrier.subresourceRange.baseMipLevel = i - 1;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        _vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkImageBlit blit{};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = i - 1;
+        blit.srcSubresource.layerCount = 1;
+        blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel = i;
+        blit.dstSubresource.layerCount = 1;
+        blit.dstOffsets[1] = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
+
+        _vkCmdBlitImage(commandBuffer,
+            image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit,
+            VK_FILTER_LINEAR);
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        _vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        mipWidth = blit.dstOffsets[1].x;
+        mipHeight = blit.dstOffsets[1].y;
     }
+
+    barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    _vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
 }
 
 void VulkanHook_t::_LoadResources()
 {
-    VkResult result;
-
     struct ValidTexture_t
     {
         std::shared_ptr<VulkanTexture_t> Resource;
-        const void* Data;
+        VkBuffer UploadBuffer;
+        VkDeviceSize Offset;
+        uint32_t X;
+        uint32_t Y;
         uint32_t Width;
         uint32_t Height;
-        VkDeviceSize Offset;
-        VkDeviceSize Size;
+        VkFormat Format;
+        VkComponentMapping Components;
+        uint32_t MipLevels;
     };
 
+    _PollUploadBatches(false);
+
+    if ((_ImageResourcesToLoad.empty() && _ImageResourcesToUpdate.empty()) || !_CreateStagingRing())
+        return;
+
+    VulkanUploadBatch_t uploadBatch;
+    if (!_AcquireUploadBatch(uploadBatch))
+        return;
+
     std::vector<ValidTexture_t> validResources;
+    std::vector<ValidTexture_t> validUpdates;
+    std::vector<VulkanUploadBuffer_t> dedicatedBuffers;
 
-    const auto loadParameterCount = _ImageResourcesToLoad.size() > _BatchSize ? _BatchSize : _ImageResourcesToLoad.size();
+    const auto loadParameterCount = _BeginLoadBatch(_ImageResourcesToLoad);
+    size_t processedCount = 0;
+    uint64_t loadedBytes = 0;
 
-    for (size_t i = 0; i < loadParameterCount; ++i)
+    for (; processedCount < loadParameterCount; ++processedCount)
     {
-        auto& param = _ImageResourcesToLoad[i];
+        auto& param = _ImageResourcesToLoad[processedCount];
 
-        auto r = param.Resource.lock();
+        auto r = _GetTexture(param.Resource);
         if (!r) continue;
 
         ValidTexture_t t{};
         t.Resource = std::static_pointer_cast<VulkanTexture_t>(r);
-        t.Data = param.Data;
         t.Width = param.Width;
         t.Height = param.Height;
-        t.Size = t.Width * t.Height * 4;
-
-        validResources.push_back(t);
-    }
-
-    if (validResources.empty())
-        return;
+        t.Format = ResourceFormatToVkFormat(param.Format);
+        t.Components = ResourceFormatToVkComponents(param.Format);
+        t.MipLevels = param.GenerateMipmaps ? GetMipLevelCount(param.Width, param.Height) : 1;
+
+        const auto size = GetResourceFormatDataSize(param.Format, param.Width, param.Height);
+        const auto stageResult = _StageUpload(param.Data, size, dedicatedBuffers, t.UploadBuffer, t.Offset);
+        // The staging ring is full, keep the remaining resources for the next frame.
+        if (stageResult == StageResult_t::RingFull)
+            break;
 
-    VkDeviceSize totalUploadSize = 0;
+        if (stageResult == StageResult_t::Failed)
+        {
+            _SetTextureLoadStatus(t.Resource->Handle, RendererTextureStatus_e::NotLoaded);
+            continue;
+        }
 
-    for (auto& v : validResources)
-    {
-        v.Offset = totalUploadSize;
-        totalUploadSize += v.Size;
+        loadedBytes += size;
+        validResources.emplace_back(std::move(t));
     }
 
-    VkBuffer uploadBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory uploadBufferMemory = VK_NULL_HANDLE;
+    _ImageResourcesToLoad.erase(
+        _ImageResourcesToLoad.begin(),
+        _ImageResourcesToLoad.begin() + processedCount);
 
+    for (processedCount = 0; processedCount < _ImageResourcesToUpdate.size(); ++processedCount)
     {
-        VkBufferCreateInfo buffer_info{};
-        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buffer_info.size = totalUploadSize;
-        buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        auto& param = _ImageResourcesToUpdate[processedCount];
 
-        result = _vkCreateBuffer(_VulkanDevice, &buffer_info, _VulkanAllocationCallbacks, &uploadBuffer);
-        _CheckVkResult(result);
+        auto r = std::static_pointer_cast<VulkanTexture_t>(_GetTexture(param.Resource));
+        if (!r || r->VulkanImage == VK_NULL_HANDLE) continue;
 
-        VkMemoryRequirements req;
-        _vkGetBufferMemoryRequirements(_VulkanDevice, uploadBuffer, &req);
+        ValidTexture_t t{};
+        t.Resource = std::move(r);
+        t.X = param.X;
+        t.Y = param.Y;
+        t.Width = param.Width;
+        t.Height = param.Height;
 
-        VkMemoryAllocateInfo alloc{};
-        alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc.allocationSize = req.size;
-        alloc.memoryTypeIndex = _GetVulkanMemoryType(
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            req.memoryTypeBits);
+        const auto stageResult = _StageUpload(param.Data.data(), param.Data.size(), dedicatedBuffers, t.UploadBuffer, t.Offset);
+        if (stageResult == StageResult_t::RingFull)
+            break;
 
-        result = _vkAllocateMemory(_VulkanDevice, &alloc, _VulkanAllocationCallbacks, &uploadBufferMemory);
-        _CheckVkResult(result);
+        // The update is dropped, the texture keeps its previous pixels.
+        if (stageResult == StageResult_t::Failed)
+            continue;
 
-        _vkBindBufferMemory(_VulkanDevice, uploadBuffer, uploadBufferMemory, 0);
+        validUpdates.emplace_back(std::move(t));
     }
 
-    {
-        uint8_t* map = nullptr;
-        _vkMapMemory(_VulkanDevice, uploadBufferMemory, 0, totalUploadSize, 0, (void**)&map);
+    _ImageResourcesToUpdate.erase(
+        _ImageResourcesToUpdate.begin(),
+        _ImageResourcesToUpdate.begin() + processedCount);
 
-        for (auto& v : validResources)
-            memcpy(map + v.Offset, v.Data, v.Size);
+    if (validResources.empty() && validUpdates.empty())
+    {
+        for (auto& uploadBuffer : dedicatedBuffers)
+            _DestroyUploadBuffer(uploadBuffer);
 
-        _vkUnmapMemory(_VulkanDevice, uploadBufferMemory);
+        _FreeUploadBatches.emplace_back(std::move(uploadBatch));
+        return;
     }
 
-    _vkResetCommandPool(_VulkanDevice, _VulkanImageCommandPool, 0);
-
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-    _vkBeginCommandBuffer(_VulkanImageCommandBuffer, &beginInfo);
+    _vkBeginCommandBuffer(uploadBatch.CommandBuffer, &beginInfo);
 
     for (auto& tex : validResources)
     {
         VkImage image = VK_NULL_HANDLE;
         VkImageView view = VK_NULL_HANDLE;
-        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VulkanMemoryAllocation_t memory;
 
         VkImageCreateInfo info{};
         info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         info.imageType = VK_IMAGE_TYPE_2D;
-        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.format = tex.Format;
         info.extent = { tex.Width, tex.Height, 1 };
-        info.mipLevels = 1;
+        info.mipLevels = tex.MipLevels;
         info.arrayLayers = 1;
         info.samples = VK_SAMPLE_COUNT_1_BIT;
         info.tiling = VK_IMAGE_TILING_OPTIMAL;
         info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        // The mipmaps are blitted from the level above them.
+        if (tex.MipLevels > 1)
+            info.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
 
         _vkCreateImage(_VulkanDevice, &info, _VulkanAllocationCallbacks, &image);
 
         VkMemoryRequirements req;
         _vkGetImageMemoryRequirements(_VulkanDevice, image, &req);
 
-        VkMemoryAllocateInfo alloc{};
-        alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc.allocationSize = req.size;
-        alloc.memoryTypeIndex = _GetVulkanMemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, req.memoryTypeBits);
+        if (!_AllocateImageMemory(req, memory))
+        {
+            _vkDestroyImage(_VulkanDevice, image, _VulkanAllocationCallbacks);
+            _SetTextureLoadStatus(tex.Resource->Handle, RendererTextureStatus_e::NotLoaded);
+            continue;
+        }
 
-        _vkAllocateMemory(_VulkanDevice, &alloc, _VulkanAllocationCallbacks, &memory);
-        _vkBindImageMemory(_VulkanDevice, image, memory, 0);
+        _vkBindImageMemory(_VulkanDevice, image, memory.Block->Memory, memory.Offset);
 
         VkImageViewCreateInfo viewInfo{};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         viewInfo.image = image;
         viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+        viewInfo.format = tex.Format;
+        viewInfo.components = tex.Components;
         viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.levelCount = tex.MipLevels;
         viewInfo.subresourceRange.layerCount = 1;
 
         _vkCreateImageView(_VulkanDevice, &viewInfo, _VulkanAllocationCallbacks, &view);
@@ -1119,10 +1576,10 @@ void VulkanHook_t::_LoadResources()
         barrier1.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         barrier1.image = image;
         barrier1.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier1.subresourceRange.levelCount = 1;
+        barrier1.subresourceRange.levelCount = tex.MipLevels;
         barrier1.subresourceRange.layerCount = 1;
 
-        _vkCmdPipelineBarrier(_VulkanImageCommandBuffer,
+        _vkCmdPipelineBarrier(uploadBatch.CommandBuffer,
             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
             VK_PIPELINE_STAGE_TRANSFER_BIT,
             0, 0, nullptr, 0, nullptr, 1, &barrier1);
@@ -1134,229 +1591,423 @@ void VulkanHook_t::_LoadResources()
         region.imageExtent = { tex.Width, tex.Height, 1 };
 
         _vkCmdCopyBufferToImage(
-            _VulkanImageCommandBuffer,
-            uploadBuffer,
+            uploadBatch.CommandBuffer,
+            tex.UploadBuffer,
             image,
             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
             1,
             &region);
 
-        VkImageMemoryBarrier barrier2{};
-        barrier2.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier2.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier2.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier2.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier2.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        barrier2.image = image;
-        barrier2.subresourceRange = barrier1.subresourceRange;
-
-        _vkCmdPipelineBarrier(_VulkanImageCommandBuffer,
-            VK_PIPELINE_STAGE_TRANSFER_BIT,
-            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-            0, 0, nullptr, 0, nullptr, 1, &barrier2);
+        if (tex.MipLevels > 1)
+        {
+            _GenerateMipmaps(uploadBatch.CommandBuffer, image, tex.Width, tex.Height, tex.MipLevels);
+        }
+        else
+        {
+            VkImageMemoryBarrier barrier2{};
+            barrier2.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier2.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier2.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier2.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier2.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier2.image = image;
+            barrier2.subresourceRange = barrier1.subresourceRange;
+
+            _vkCmdPipelineBarrier(uploadBatch.CommandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &barrier2);
+        }
 
         tex.Resource->VulkanImage = image;
         tex.Resource->VulkanImageMemory = memory;
         tex.Resource->VulkanImageView = view;
-        tex.Resource->LoadStatus = RendererTextureStatus_e::Loaded;
+        tex.Resource->Width = tex.Width;
+        tex.Resource->Height = tex.Height;
+        tex.Resource->MipLevels = tex.MipLevels;
+        uploadBatch.Textures.emplace_back(std::move(tex.Resource));
     }
 
-    _vkEndCommandBuffer(_VulkanImageCommandBuffer);
+    for (auto& tex : validUpdates)
+    {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.image = tex.Resource->VulkanImage;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = tex.Resource->MipLevels;
+        barrier.subresourceRange.layerCount = 1;
+
+        // Wait for the previous frames to be done sampling the texture.
+        _vkCmdPipelineBarrier(uploadBatch.CommandBuffer,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = tex.Offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { int32_t(tex.X), int32_t(tex.Y), 0 };
+        region.imageExtent = { tex.Width, tex.Height, 1 };
+
+        _vkCmdCopyBufferToImage(
+            uploadBatch.CommandBuffer,
+            tex.UploadBuffer,
+            tex.Resource->VulkanImage,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1,
+            &region);
+
+        if (tex.Resource->MipLevels > 1)
+        {
+            // The mipmaps are generated again from the updated level.
+            _GenerateMipmaps(uploadBatch.CommandBuffer, tex.Resource->VulkanImage, tex.Resource->Width, tex.Resource->Height, tex.Resource->MipLevels);
+        }
+        else
+        {
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            _vkCmdPipelineBarrier(uploadBatch.CommandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+
+        uploadBatch.Textures.emplace_back(std::move(tex.Resource));
+    }
+
+    _vkEndCommandBuffer(uploadBatch.CommandBuffer);
 
     VkSubmitInfo submit{};
     submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submit.commandBufferCount = 1;
-    submit.pCommandBuffers = &_VulkanImageCommandBuffer;
+    submit.pCommandBuffers = &uploadBatch.CommandBuffer;
 
-    _vkQueueSubmit(_VulkanQueue, 1, &submit, _VulkanImageFence);
-    _vkWaitForFences(_VulkanDevice, 1, &_VulkanImageFence, VK_TRUE, UINT64_MAX);
-    _vkResetFences(_VulkanDevice, 1, &_VulkanImageFence);
+    _vkQueueSubmit(_VulkanQueue, 1, &submit, uploadBatch.Fence);
 
-    _vkDestroyBuffer(_VulkanDevice, uploadBuffer, _VulkanAllocationCallbacks);
-    _vkFreeMemory(_VulkanDevice, uploadBufferMemory, _VulkanAllocationCallbacks);
+    // Don't wait for the copy, the resources will be flagged as loaded once the fence is signaled.
+    uploadBatch.StagingHead = _StagingRing.Head;
+    uploadBatch.UploadBuffers = std::move(dedicatedBuffers);
+    _PendingUploadBatches.emplace_back(std::move(uploadBatch));
 
-    _ImageResourcesToLoad.erase(
-        _ImageResourcesToLoad.begin(),
-        _ImageResourcesToLoad.begin() + loadParameterCount);
+    _EndLoadBatch(loadedBytes);
 }
 
 void VulkanHook_t::_ReleaseResources()
 {
-    if (_ImageResourcesToRelease.empty())
-        return;
+    // The frame fences were waited before recording, the textures of the completed frames can be destroyed.
+    _ReleaseRetiredTextures();
+}
+
+bool VulkanHook_t::_CreateScreenshotBuffer(VulkanFrame_t& frame, VkDeviceSize size)
+{
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    if (_CheckVkResult(_vkCreateBuffer(_VulkanDevice, &bufferInfo, _VulkanAllocationCallbacks, &frame.ScreenshotBuffer)) != VkResult::VK_SUCCESS)
+        return false;
 
-    for (auto it = _ImageResourcesToRelease.begin(); it != _ImageResourcesToRelease.end();)
+    VkMemoryRequirements req;
+    _vkGetBufferMemoryRequirements(_VulkanDevice, frame.ScreenshotBuffer, &req);
+
+    // The CPU reads the whole buffer back, prefer the cached memory when there is one.
+    VkMemoryAllocateInfo alloc{};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = req.size;
+    alloc.memoryTypeIndex = _GetVulkanMemoryType(
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+        req.memoryTypeBits);
+
+    if (alloc.memoryTypeIndex == 0xFFFFFFFF)
     {
-        if ((it->ReleaseFrame + _OverlayFrames.size()) < _CurrentFrame)
-        {
-            it = _ImageResourcesToRelease.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        alloc.memoryTypeIndex = _GetVulkanMemoryType(
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            req.memoryTypeBits);
     }
+
+    if (_CheckVkResult(_vkAllocateMemory(_VulkanDevice, &alloc, _VulkanAllocationCallbacks, &frame.ScreenshotMemory)) != VkResult::VK_SUCCESS ||
+        _CheckVkResult(_vkBindBufferMemory(_VulkanDevice, frame.ScreenshotBuffer, frame.ScreenshotMemory, 0)) != VkResult::VK_SUCCESS ||
+        _CheckVkResult(_vkMapMemory(_VulkanDevice, frame.ScreenshotMemory, 0, size, 0, &frame.ScreenshotData)) != VkResult::VK_SUCCESS)
+    {
+        _DestroyScreenshotBuffer(frame);
+        return false;
+    }
+
+    frame.ScreenshotBufferSize = size;
+    return true;
 }
 
-void VulkanHook_t::_HandleScreenshot(VulkanFrame_t& frame)
+void VulkanHook_t::_DestroyScreenshotBuffer(VulkanFrame_t& frame)
 {
-    const int32_t width = ImGui::GetIO().DisplaySize.x;
-    const int32_t height = ImGui::GetIO().DisplaySize.y;
-
-    bool result = false;
-
-    VkResult vkResult;
-
-    // 1. Create staging image (host-visible)
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.format = _VulkanTargetFormat;
-    imageInfo.extent.width = width;
-    imageInfo.extent.height = height;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.tiling = VK_IMAGE_TILING_LINEAR;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-
-    VkImage dstImage = VK_NULL_HANDLE;
-    VkDeviceMemory dstMemory = VK_NULL_HANDLE;
-    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
-
-    VkMemoryRequirements memReqs{};
-    VkMemoryAllocateInfo allocInfo{};
-    VkPhysicalDeviceMemoryProperties memProps{};
-    VkCommandBufferAllocateInfo cmdBufAllocInfo{};
-    VkCommandBufferBeginInfo beginInfo{};
-    VkImageMemoryBarrier barrier{};
-    VkImageCopy imageCopy{};
-    VkSubmitInfo submitInfo{};
-    VkImageSubresource subresource{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 0 };
-    VkSubresourceLayout layout{};
+    // The frame is destroyed before its copy was delivered, the screenshot is dropped.
+    if (frame.ScreenshotPending)
+    {
+        frame.ScreenshotPending = false;
+        _SendScreenshot(nullptr, frame.ScreenshotId);
+    }
+
+    if (frame.ScreenshotData != nullptr)
+        _vkUnmapMemory(_VulkanDevice, frame.ScreenshotMemory);
 
-    const char* mapped = nullptr;
+    if (frame.ScreenshotBuffer != VK_NULL_HANDLE)
+        _vkDestroyBuffer(_VulkanDevice, frame.ScreenshotBuffer, _VulkanAllocationCallbacks);
 
-    vkResult = _vkCreateImage(_VulkanDevice, &imageInfo, nullptr, &dstImage);
-    if (vkResult != VK_SUCCESS)
-        goto cleanup;
+    if (frame.ScreenshotMemory != VK_NULL_HANDLE)
+        _vkFreeMemory(_VulkanDevice, frame.ScreenshotMemory, _VulkanAllocationCallbacks);
 
-    // 2. Allocate memory for staging image
-    _vkGetImageMemoryRequirements(_VulkanDevice, dstImage, &memReqs);
+    frame.ScreenshotBuffer = VK_NULL_HANDLE;
+    frame.ScreenshotMemory = VK_NULL_HANDLE;
+    frame.ScreenshotData = nullptr;
+    frame.ScreenshotBufferSize = 0;
+}
 
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memReqs.size;
+bool VulkanHook_t::_CreateScreenshotScaledImage(uint32_t width, uint32_t height)
+{
+    if (_ScreenshotScaledImage != VK_NULL_HANDLE && _ScreenshotScaledWidth == width && _ScreenshotScaledHeight == height)
+        return true;
 
-    // Find host-visible memory type
-    _vkGetPhysicalDeviceMemoryProperties(_VulkanPhysicalDevice, &memProps);
-    for (uint32_t i = 0; i < memProps.memoryTypeCount; i++)
+    if (_ScreenshotScaledImage != VK_NULL_HANDLE)
     {
-        if ((memReqs.memoryTypeBits & (1 << i)) &&
-            (memProps.memoryTypes[i].propertyFlags & (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)))
+        // The copies still in flight read the old image, they are completed before it is replaced.
+        for (auto& frame : _OverlayFrames)
         {
-            allocInfo.memoryTypeIndex = i;
-            break;
+            if (frame.ScreenshotPending)
+                _vkWaitForFences(_VulkanDevice, 1, &frame.Fence, VK_TRUE, UINT64_MAX);
         }
+        _PollScreenshots();
     }
 
-    vkResult = _vkAllocateMemory(_VulkanDevice, &allocInfo, nullptr, &dstMemory);
-    if (vkResult != VK_SUCCESS)
-        goto cleanup;
+    _DestroyScreenshotScaledImage();
 
-    vkResult = _vkBindImageMemory(_VulkanDevice, dstImage, dstMemory, 0);
-    if (vkResult != VK_SUCCESS)
-        goto cleanup;
+    // The linear filter must be supported by the swapchain format.
+    if (_vkGetPhysicalDeviceFormatProperties == nullptr)
+        return false;
 
-    // 3. Command buffer: Copy from srcImage to dstImage
-    cmdBufAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cmdBufAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cmdBufAllocInfo.commandPool = frame.CommandPool;
-    cmdBufAllocInfo.commandBufferCount = 1;
+    const VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    VkFormatProperties properties{};
+    _vkGetPhysicalDeviceFormatProperties(_VulkanPhysicalDevice, _VulkanTargetFormat, &properties);
+    if ((properties.optimalTilingFeatures & blitFeatures) != blitFeatures)
+        return false;
 
-    vkResult = _vkAllocateCommandBuffers(_VulkanDevice, &cmdBufAllocInfo, &cmdBuffer);
-    if (vkResult != VK_SUCCESS)
-        goto cleanup;
+    VkImageCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    info.imageType = VK_IMAGE_TYPE_2D;
+    info.format = _VulkanTargetFormat;
+    info.extent.width = width;
+    info.extent.height = height;
+    info.extent.depth = 1;
+    info.mipLevels = 1;
+    info.arrayLayers = 1;
+    info.samples = VK_SAMPLE_COUNT_1_BIT;
+    info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    info.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (_CheckVkResult(_vkCreateImage(_VulkanDevice, &info, _VulkanAllocationCallbacks, &_ScreenshotScaledImage)) != VkResult::VK_SUCCESS)
+    {
+        _ScreenshotScaledImage = VK_NULL_HANDLE;
+        return false;
+    }
 
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VkMemoryRequirements req;
+    _vkGetImageMemoryRequirements(_VulkanDevice, _ScreenshotScaledImage, &req);
 
-    vkResult = _vkBeginCommandBuffer(cmdBuffer, &beginInfo);
-    if (vkResult != VK_SUCCESS)
-        goto cleanup;
+    VkMemoryAllocateInfo alloc{};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = req.size;
+    alloc.memoryTypeIndex = _GetVulkanMemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, req.memoryTypeBits);
 
-    // Transition dst image to transfer dst layout
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
-    barrier.image = dstImage;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.layerCount = 1;
-    barrier.srcAccessMask = 0;
-    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    if (_CheckVkResult(_vkAllocateMemory(_VulkanDevice, &alloc, _VulkanAllocationCallbacks, &_ScreenshotScaledMemory)) != VkResult::VK_SUCCESS ||
+        _CheckVkResult(_vkBindImageMemory(_VulkanDevice, _ScreenshotScaledImage, _ScreenshotScaledMemory, 0)) != VkResult::VK_SUCCESS)
+    {
+        _DestroyScreenshotScaledImage();
+        return false;
+    }
 
-    _vkCmdPipelineBarrier(cmdBuffer,
-        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-        0, 0, nullptr, 0, nullptr, 1, &barrier);
+    _ScreenshotScaledWidth = width;
+    _ScreenshotScaledHeight = height;
+    return true;
+}
 
-    // Copy from src (swapchain) to dst (linear)
-    imageCopy.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    imageCopy.srcSubresource.layerCount = 1;
-    imageCopy.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    imageCopy.dstSubresource.layerCount = 1;
-    imageCopy.extent.width = width;
-    imageCopy.extent.height = height;
-    imageCopy.extent.depth = 1;
+void VulkanHook_t::_DestroyScreenshotScaledImage()
+{
+    if (_ScreenshotScaledImage != VK_NULL_HANDLE)
+        _vkDestroyImage(_VulkanDevice, _ScreenshotScaledImage, _VulkanAllocationCallbacks);
 
-    _vkCmdCopyImage(cmdBuffer,
-        frame.BackBuffer, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-        dstImage, VK_IMAGE_LAYOUT_GENERAL,
-        1, &imageCopy);
+    if (_ScreenshotScaledMemory != VK_NULL_HANDLE)
+        _vkFreeMemory(_VulkanDevice, _ScreenshotScaledMemory, _VulkanAllocationCallbacks);
 
-    _vkEndCommandBuffer(cmdBuffer);
+    _ScreenshotScaledImage = VK_NULL_HANDLE;
+    _ScreenshotScaledMemory = VK_NULL_HANDLE;
+    _ScreenshotScaledWidth = 0;
+    _ScreenshotScaledHeight = 0;
+}
 
-    // Submit and wait
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmdBuffer;
-    _vkQueueSubmit(_VulkanQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    _vkQueueWaitIdle(_VulkanQueue);
+void VulkanHook_t::_PollScreenshots()
+{
+    for (auto& frame : _OverlayFrames)
+    {
+        if (!frame.ScreenshotPending || _vkGetFenceStatus(_VulkanDevice, frame.Fence) != VkResult::VK_SUCCESS)
+            continue;
 
-    // 4. Map memory
-    _vkGetImageSubresourceLayout(_VulkanDevice, dstImage, &subresource, &layout);
+        frame.ScreenshotPending = false;
 
-    void* data;
-    vkResult = _vkMapMemory(_VulkanDevice, dstMemory, 0, VK_WHOLE_SIZE, 0, &data);
-    if (vkResult != VK_SUCCESS)
-        goto cleanup;
+        ScreenshotCallbackParameter_t screenshot;
+        screenshot.Width = frame.ScreenshotWidth;
+        screenshot.Height = frame.ScreenshotHeight;
+        screenshot.Pitch = frame.ScreenshotWidth * VkFormatPixelSize(_VulkanTargetFormat);
+        screenshot.Data = frame.ScreenshotData;
+        screenshot.Format = RendererFormatToScreenshotFormat(_VulkanTargetFormat);
 
-    ScreenshotCallbackParameter_t screenshot;
-    screenshot.Width = width;
-    screenshot.Height = height;
-    screenshot.Pitch = layout.rowPitch;
-    screenshot.Data = reinterpret_cast<void*>(data);
-    screenshot.Format = RendererFormatToScreenshotFormat(_VulkanTargetFormat);
+        _SendScreenshot(&screenshot, frame.ScreenshotId);
+    }
+}
 
-    _SendScreenshot(&screenshot);
+void VulkanHook_t::_HandleScreenshot(VulkanFrame_t& frame)
+{
+    const uint32_t backBufferWidth = ImGui::GetIO().DisplaySize.x;
+    const uint32_t backBufferHeight = ImGui::GetIO().DisplaySize.y;
 
-    _vkUnmapMemory(_VulkanDevice, dstMemory);
+    const auto screenshotRegion = _ScreenshotRegion(backBufferWidth, backBufferHeight);
+    if (screenshotRegion.Width == 0 || screenshotRegion.Height == 0)
+    {
+        _SendScreenshot(nullptr);
+        return;
+    }
 
-    result = true;
+    // A thumbnail is blitted to a smaller image first, only its pixels are read back.
+    uint32_t width = screenshotRegion.TargetWidth;
+    uint32_t height = screenshotRegion.TargetHeight;
+    const bool scaled = (width != screenshotRegion.Width || height != screenshotRegion.Height) && _CreateScreenshotScaledImage(width, height);
+    if (!scaled)
+    {
+        width = screenshotRegion.Width;
+        height = screenshotRegion.Height;
+    }
 
-cleanup:
-    if (dstImage != VK_NULL_HANDLE)
-        _vkDestroyImage(_VulkanDevice, dstImage, nullptr);
+    const VkDeviceSize size = VkDeviceSize(width) * height * VkFormatPixelSize(_VulkanTargetFormat);
 
-    if (dstMemory != VK_NULL_HANDLE)
-        _vkFreeMemory(_VulkanDevice, dstMemory, nullptr);
+    // The previous copy of this frame was sent when its fence was waited.
+    if (frame.ScreenshotBufferSize < size)
+    {
+        _DestroyScreenshotBuffer(frame);
+        if (!_CreateScreenshotBuffer(frame, size))
+        {
+            _SendScreenshot(nullptr);
+            return;
+        }
+    }
 
-    if (cmdBuffer != VK_NULL_HANDLE)
-        _vkFreeCommandBuffers(_VulkanDevice, frame.CommandPool, 1, &cmdBuffer);
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = frame.BackBuffer;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
 
-    if (!result)
-        _SendScreenshot(nullptr);
+    // Waits for the game or the overlay rendering before reading the back buffer.
+    barrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    // The scaled image content is discarded, the copy of a previous frame must be done reading it.
+    VkImageMemoryBarrier scaledBarrier = barrier;
+    scaledBarrier.image = _ScreenshotScaledImage;
+    scaledBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    scaledBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    scaledBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    scaledBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    const VkImageMemoryBarrier sourceBarriers[] = { barrier, scaledBarrier };
+    _vkCmdPipelineBarrier(frame.CommandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, scaled ? 2 : 1, sourceBarriers);
+
+    VkImage copySource = frame.BackBuffer;
+    if (scaled)
+    {
+        VkImageBlit blit{};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.layerCount = 1;
+        blit.srcOffsets[0] = { int32_t(screenshotRegion.X), int32_t(screenshotRegion.Y), 0 };
+        blit.srcOffsets[1] = { int32_t(screenshotRegion.X + screenshotRegion.Width), int32_t(screenshotRegion.Y + screenshotRegion.Height), 1 };
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.layerCount = 1;
+        blit.dstOffsets[1] = { int32_t(width), int32_t(height), 1 };
+
+        _vkCmdBlitImage(frame.CommandBuffer,
+            frame.BackBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            _ScreenshotScaledImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit,
+            VK_FILTER_LINEAR);
+
+        scaledBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        scaledBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        scaledBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        scaledBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        _vkCmdPipelineBarrier(frame.CommandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &scaledBarrier);
+
+        copySource = _ScreenshotScaledImage;
+    }
+
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    // The scaled image only holds the rectangle.
+    if (!scaled)
+    {
+        region.imageOffset.x = int32_t(screenshotRegion.X);
+        region.imageOffset.y = int32_t(screenshotRegion.Y);
+    }
+    region.imageExtent.width = width;
+    region.imageExtent.height = height;
+    region.imageExtent.depth = 1;
+
+    _vkCmdCopyImageToBuffer(frame.CommandBuffer,
+        copySource, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        frame.ScreenshotBuffer,
+        1, &region);
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    VkBufferMemoryBarrier bufferBarrier{};
+    bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferBarrier.buffer = frame.ScreenshotBuffer;
+    bufferBarrier.size = VK_WHOLE_SIZE;
+
+    _vkCmdPipelineBarrier(frame.CommandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0, 0, nullptr, 1, &bufferBarrier, 1, &barrier);
+
+    frame.ScreenshotWidth = width;
+    frame.ScreenshotHeight = height;
+    frame.ScreenshotPending = true;
+
+    // The request is consumed now, the data is sent once the frame fence is signaled.
+    frame.ScreenshotId = _BeginScreenshot();
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL VulkanHook_t::_MyVkAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout, VkSemaphore semaphore, VkFence fence, uint32_t* pImageIndex)
@@ -1438,12 +2089,15 @@ VulkanHook_t::VulkanHook_t() :
     _VulkanPhysicalDevice(VK_NULL_HANDLE),
     _VulkanQueueFamily(uint32_t(-1)),
     _VulkanImageCommandPool(VK_NULL_HANDLE),
-    _VulkanImageCommandBuffer(VK_NULL_HANDLE),
-    _VulkanImageFence(VK_NULL_HANDLE),
+    _BufferImageGranularity(0),
     _VulkanImageSampler(VK_NULL_HANDLE),
     _VulkanImageDescriptorSetLayout(VK_NULL_HANDLE),
     _VulkanRenderPass(VK_NULL_HANDLE),
     _VulkanTargetFormat(VK_FORMAT_R8G8B8A8_UNORM),
+    _ScreenshotScaledImage(VK_NULL_HANDLE),
+    _ScreenshotScaledMemory(VK_NULL_HANDLE),
+    _ScreenshotScaledWidth(0),
+    _ScreenshotScaledHeight(0),
     _VulkanDevice(VK_NULL_HANDLE),
     _VulkanQueue(VK_NULL_HANDLE),
     _ImGuiFontAtlas(nullptr),
@@ -1461,13 +2115,11 @@ VulkanHook_t::VulkanHook_t() :
     _vkGetDeviceProcAddr(nullptr),
     _vkGetDeviceQueue(nullptr),
     _vkQueueSubmit(nullptr),
-    _vkQueueWaitIdle(nullptr),
     _vkCreateRenderPass(nullptr),
     _vkCmdBeginRenderPass(nullptr),
     _vkCmdEndRenderPass(nullptr),
     _vkDestroyRenderPass(nullptr),
-    _vkCmdCopyImage(nullptr),
-    _vkGetImageSubresourceLayout(nullptr),
+    _vkCmdCopyImageToBuffer(nullptr),
     _vkCreateSemaphore(nullptr),
     _vkDestroySemaphore(nullptr),
     _vkCreateBuffer(nullptr),
@@ -1477,6 +2129,7 @@ VulkanHook_t::VulkanHook_t() :
     _vkFlushMappedMemoryRanges(nullptr),
     _vkBindBufferMemory(nullptr),
     _vkCmdCopyBufferToImage(nullptr),
+    _vkCmdBlitImage(nullptr),
     _vkBindImageMemory(nullptr),
     _vkCreateCommandPool(nullptr),
     _vkResetCommandPool(nullptr),
@@ -1499,6 +2152,7 @@ VulkanHook_t::VulkanHook_t() :
     _vkDestroyFramebuffer(nullptr),
     _vkCreateFence(nullptr),
     _vkWaitForFences(nullptr),
+    _vkGetFenceStatus(nullptr),
     _vkResetFences(nullptr),
     _vkDestroyFence(nullptr),
     _vkCreateDescriptorPool(nullptr),
@@ -1507,7 +2161,6 @@ VulkanHook_t::VulkanHook_t() :
     _vkDestroyDescriptorSetLayout(nullptr),
     _vkAllocateDescriptorSets(nullptr),
     _vkUpdateDescriptorSets(nullptr),
-    _vkFreeDescriptorSets(nullptr),
     _vkGetBufferMemoryRequirements(nullptr),
     _vkGetImageMemoryRequirements(nullptr),
     _vkEnumeratePhysicalDevices(nullptr),
@@ -1515,6 +2168,7 @@ VulkanHook_t::VulkanHook_t() :
     _vkGetPhysicalDeviceProperties(nullptr),
     _vkGetPhysicalDeviceQueueFamilyProperties(nullptr),
     _vkGetPhysicalDeviceMemoryProperties(nullptr),
+    _vkGetPhysicalDeviceFormatProperties(nullptr),
     _vkEnumerateDeviceExtensionProperties(nullptr)
 {
 }
@@ -1526,6 +2180,10 @@ VulkanHook_t::~VulkanHook_t()
     if (_X11Hooked)
         delete X11Hook_t::Inst();
 
+    // The texture objects are released with the renderer members, before the base class is destroyed.
+    _ClearTextures();
+    _ClearRetiredTextures();
+
     _Instance->UnhookAll();
     _Instance = nullptr;
 }
@@ -1548,6 +2206,29 @@ RendererHookType_t VulkanHook_t::GetRendererHookType() const
     return RendererHookType_t::Vulkan;
 }
 
+bool VulkanHook_t::GetTextureMemoryStats(RendererTextureMemoryStats_t* stats)
+{
+    if (stats == nullptr)
+        return false;
+
+    *stats = RendererTextureMemoryStats_t{};
+    for (auto& block : _ImageMemoryBlocks)
+    {
+        ++stats->BlockCount;
+        stats->BlockBytes += block->Size;
+        stats->AllocationCount += block->AllocationCount;
+        stats->UsedBytes += block->UsedSize;
+        for (auto& range : block->FreeRanges)
+        {
+            ++stats->FreeRangeCount;
+            if (range.Size > stats->LargestFreeRange)
+                stats->LargestFreeRange = range.Size;
+        }
+    }
+
+    return true;
+}
+
 void VulkanHook_t::LoadFunctions(
     std::function<void* (const char*)> vkLoader,
     decltype(::vkAcquireNextImageKHR)* vkAcquireNextImageKHR,
@@ -1565,11 +2246,11 @@ void VulkanHook_t::LoadFunctions(
     _VkDestroyDevice = vkDestroyDevice;
 }
 
-std::weak_ptr<RendererTexture_t> VulkanHook_t::AllocImageResource()
+RendererTextureHandle_t VulkanHook_t::AllocImageResource()
 {
     auto vulkanImageDescriptor = _GetFreeDescriptorSet();
     if (vulkanImageDescriptor.DescriptorPoolId == VulkanDescriptorSet_t::InvalidDescriptorPoolId)
-        return std::weak_ptr<RendererTexture_t>{};
+        return RendererTextureHandle_t{};
 
     auto ptr = std::shared_ptr<VulkanTexture_t>(new VulkanTexture_t, [this](VulkanTexture_t* handle)
     {
@@ -1577,8 +2258,8 @@ std::weak_ptr<RendererTexture_t> VulkanHook_t::AllocImageResource()
         {
             _ReleaseDescriptor(handle->ImageDescriptorId);
             _vkDestroyImageView(_VulkanDevice, handle->VulkanImageView, _VulkanAllocationCallbacks);
-            _vkFreeMemory(_VulkanDevice, handle->VulkanImageMemory, _VulkanAllocationCallbacks);
             _vkDestroyImage(_VulkanDevice, handle->VulkanImage, _VulkanAllocationCallbacks);
+            _FreeImageMemory(handle->VulkanImageMemory);
 
             delete handle;
         }
@@ -1587,9 +2268,21 @@ std::weak_ptr<RendererTexture_t> VulkanHook_t::AllocImageResource()
     ptr->ImGuiTextureId = (uint64_t)vulkanImageDescriptor.DescriptorSet;
     ptr->ImageDescriptorId = vulkanImageDescriptor;
 
-    _ImageResources.emplace(ptr);
+    return _InsertTexture(std::move(ptr));
+}
+
+bool VulkanHook_t::IsResourceFormatSupported(ResourceFormat_t format, uint32_t /*width*/, uint32_t /*height*/)
+{
+    if (format == ResourceFormat_t::R8G8B8A8)
+        return true;
+
+    const auto vkFormat = ResourceFormatToVkFormat(format);
+    if (vkFormat == VK_FORMAT_UNDEFINED || _VulkanPhysicalDevice == VK_NULL_HANDLE || _vkGetPhysicalDeviceFormatProperties == nullptr)
+        return false;
 
-    return ptr;
+    VkFormatProperties properties{};
+    _vkGetPhysicalDeviceFormatProperties(_VulkanPhysicalDevice, vkFormat, &properties);
+    return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
 }
 
 void VulkanHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParameter)
@@ -1597,22 +2290,17 @@ void VulkanHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParamet
     _ImageResourcesToLoad.emplace_back(loadParameter);
 }
 
-void VulkanHook_t::ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource)
+bool VulkanHook_t::UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter)
+{
+    _ImageResourcesToUpdate.emplace_back(std::move(updateParameter));
+    return true;
+}
+
+void VulkanHook_t::ReleaseImageResource(RendererTextureHandle_t resource)
 {
-    auto ptr = resource.lock();
+    auto ptr = _RemoveTexture(resource);
     if (ptr)
-    {
-        auto it = _ImageResources.find(ptr);
-        if (it != _ImageResources.end())
-        {
-            _ImageResources.erase(it);
-            _ImageResourcesToRelease.emplace_back(RendererTextureReleaseParameter_t
-            {
-                std::move(ptr),
-                _CurrentFrame
-            });
-        }
-    }
+        _RetireTexture(std::move(ptr));
 }
 
 }// namespace InGameOverlay
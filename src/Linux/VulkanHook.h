@@ -33,6 +33,7 @@ class VulkanHook_t :
 {
 public:
     constexpr static uint32_t MaxDescriptorCountPerPool = 1024;
+    constexpr static VkDeviceSize ImageMemoryBlockSize = 16 * 1024 * 1024;
 
     struct VulkanDescriptorSet_t
     {
@@ -42,6 +43,32 @@ public:
         uint32_t DescriptorPoolId = InvalidDescriptorPoolId;
     };
 
+    // Device memory block shared by the textures, the free ranges are sorted by offset.
+    struct VulkanMemoryBlock_t
+    {
+        struct FreeRange_t
+        {
+            VkDeviceSize Offset;
+            VkDeviceSize Size;
+        };
+
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        uint32_t MemoryTypeIndex = 0;
+        VkDeviceSize Size = 0;
+        VkDeviceSize UsedSize = 0;
+        uint32_t AllocationCount = 0;
+        // The block was allocated for a single texture too big for the shared blocks.
+        bool Dedicated = false;
+        std::vector<FreeRange_t> FreeRanges;
+    };
+
+    struct VulkanMemoryAllocation_t
+    {
+        VulkanMemoryBlock_t* Block = nullptr;
+        VkDeviceSize Offset = 0;
+        VkDeviceSize Size = 0;
+    };
+
 private:
     static VulkanHook_t* _Instance;
 
@@ -55,12 +82,64 @@ private:
         VkSemaphore RenderCompleteSemaphore = VK_NULL_HANDLE;
         VkSemaphore ImageAcquiredSemaphore = VK_NULL_HANDLE;
         VkFence Fence = VK_NULL_HANDLE;
+        // The overlay frame last submitted with Fence.
+        uint64_t SubmittedFrame = 0;
+        // Persistently mapped readback buffer, kept until the swapchain is recreated.
+        VkBuffer ScreenshotBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory ScreenshotMemory = VK_NULL_HANDLE;
+        void* ScreenshotData = nullptr;
+        VkDeviceSize ScreenshotBufferSize = 0;
+        uint32_t ScreenshotWidth = 0;
+        uint32_t ScreenshotHeight = 0;
+        // Returned by _BeginScreenshot.
+        uint64_t ScreenshotId = 0;
+        // Set while the copy is in flight, the screenshot is sent once Fence is signaled.
+        bool ScreenshotPending = false;
     };
 
     struct VulkanDescriptorPool_t
     {
         VkDescriptorPool DescriptorPool;
-        uint32_t UsedDescriptors = 0;
+        // Sets allocated from the pool so far, they are never freed but kept in _FreeDescriptorSets once released.
+        uint32_t AllocatedDescriptors = 0;
+    };
+
+    struct VulkanUploadBuffer_t
+    {
+        VkBuffer Buffer = VK_NULL_HANDLE;
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        uint8_t* Data = nullptr;
+        VkDeviceSize Size = 0;
+    };
+
+    // Persistently mapped upload buffer used as a ring. Head and Tail only grow, the buffer offset is their value modulo the buffer size.
+    struct VulkanStagingRing_t
+    {
+        constexpr static VkDeviceSize Alignment = 16;
+        constexpr static VkDeviceSize InvalidOffset = ~VkDeviceSize(0);
+
+        VulkanUploadBuffer_t UploadBuffer;
+        VkDeviceSize Head = 0;
+        VkDeviceSize Tail = 0;
+    };
+
+    enum class StageResult_t : uint8_t
+    {
+        Staged,
+        // The ring has no room until the in flight uploads complete.
+        RingFull,
+        // The dedicated buffer of a resource too big for the ring couldn't be created.
+        Failed,
+    };
+
+    // A submitted upload, its resources stay in the Loading state until the fence is signaled.
+    struct VulkanUploadBatch_t
+    {
+        VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+        VkFence Fence = VK_NULL_HANDLE;
+        VkDeviceSize StagingHead = 0;
+        std::vector<std::shared_ptr<RendererTexture_t>> Textures;
+        std::vector<VulkanUploadBuffer_t> UploadBuffers;
     };
 
     // Variables
@@ -77,21 +156,30 @@ private:
     std::vector<VkQueueFamilyProperties> _VulkanQueueFamilies;
     uint32_t _VulkanQueueFamily;
     VkCommandPool _VulkanImageCommandPool;
-    VkCommandBuffer _VulkanImageCommandBuffer;
-    VkFence _VulkanImageFence;
+    VulkanStagingRing_t _StagingRing;
+    std::vector<VulkanUploadBatch_t> _PendingUploadBatches;
+    std::vector<VulkanUploadBatch_t> _FreeUploadBatches;
+    std::vector<std::unique_ptr<VulkanMemoryBlock_t>> _ImageMemoryBlocks;
+    VkDeviceSize _BufferImageGranularity;
     VkSampler _VulkanImageSampler;
     VkDescriptorSetLayout _VulkanImageDescriptorSetLayout;
     std::vector<VulkanFrame_t> _OverlayFrames;
     VkRenderPass _VulkanRenderPass;
     std::vector<VulkanDescriptorPool_t> _DescriptorsPools;
+    // Released image descriptor sets, they all have the same layout and are reused as they are.
+    std::vector<VulkanDescriptorSet_t> _FreeDescriptorSets;
     VkFormat _VulkanTargetFormat;
+    // The back buffer is blitted in it when a screenshot is scaled down, then copied to the readback buffer.
+    VkImage _ScreenshotScaledImage;
+    VkDeviceMemory _ScreenshotScaledMemory;
+    uint32_t _ScreenshotScaledWidth;
+    uint32_t _ScreenshotScaledHeight;
 
     VkDevice _VulkanDevice;
     VkQueue _VulkanQueue;
 
-    std::set<std::shared_ptr<RendererTexture_t>> _ImageResources;
     std::vector<RendererTextureLoadParameter_t> _ImageResourcesToLoad;
-    std::vector<RendererTextureReleaseParameter_t> _ImageResourcesToRelease;
+    std::vector<RendererTextureUpdateParameter_t> _ImageResourcesToUpdate;
     void* _ImGuiFontAtlas;
 
     // Functions
@@ -111,7 +199,13 @@ private:
     void _PrepareForOverlay(VkQueue queue, const VkPresentInfoKHR* pPresentInfo);
     void _LoadResources();
     void _ReleaseResources();
+    // Records the back buffer copy in the frame command buffer, it must be called outside of the render pass.
     void _HandleScreenshot(VulkanFrame_t& frame);
+    void _PollScreenshots();
+    bool _CreateScreenshotBuffer(VulkanFrame_t& frame, VkDeviceSize size);
+    void _DestroyScreenshotBuffer(VulkanFrame_t& frame);
+    bool _CreateScreenshotScaledImage(uint32_t width, uint32_t height);
+    void _DestroyScreenshotScaledImage();
 
     static PFN_vkVoidFunction _LoadVulkanFunction(const char* functionName, void* userData);
     PFN_vkVoidFunction _LoadVulkanFunction(const char* functionName);
@@ -120,8 +214,6 @@ private:
     int32_t _GetPhysicalDeviceFirstGraphicsQueue(VkPhysicalDevice physicalDevice);
     bool _GetPhysicalDevice();
 
-    bool _CreateImageFence();
-    void _DestroyImageFence();
 
     bool _CreateImageSampler();
     void _DestroyImageSampler();
@@ -132,8 +224,24 @@ private:
     bool _CreateImageCommandPool();
     void _DestroyImageCommandPool();
 
-    bool _CreateImageCommandBuffer();
-    void _DestroyImageCommandBuffer();
+    bool _AcquireUploadBatch(VulkanUploadBatch_t& uploadBatch);
+    void _PollUploadBatches(bool wait);
+    void _DestroyUploadBatches();
+
+    bool _CreateUploadBuffer(VkDeviceSize size, VulkanUploadBuffer_t& uploadBuffer);
+    void _DestroyUploadBuffer(VulkanUploadBuffer_t& uploadBuffer);
+
+    bool _CreateStagingRing();
+    void _DestroyStagingRing();
+    VkDeviceSize _AllocStagingRange(VkDeviceSize size);
+    void _RetireStagingRange(VkDeviceSize head);
+    StageResult_t _StageUpload(const void* data, VkDeviceSize size, std::vector<VulkanUploadBuffer_t>& dedicatedBuffers, VkBuffer& buffer, VkDeviceSize& offset);
+    // Blits the level 0 down the mip chain, every level has to be in the transfer destination layout, they are left shader readable.
+    void _GenerateMipmaps(VkCommandBuffer commandBuffer, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels);
+
+    bool _AllocateImageMemory(VkMemoryRequirements const& requirements, VulkanMemoryAllocation_t& allocation);
+    void _FreeImageMemory(VulkanMemoryAllocation_t& allocation);
+    void _DestroyImageMemoryBlocks();
 
     bool _CreateImageDevices();
     void _DestroyImageDevices();
@@ -164,13 +272,11 @@ private:
     decltype(::vkGetDeviceProcAddr)                      *_vkGetDeviceProcAddr;
     decltype(::vkGetDeviceQueue)                         *_vkGetDeviceQueue;
     decltype(::vkQueueSubmit)                            *_vkQueueSubmit;
-    decltype(::vkQueueWaitIdle)                          *_vkQueueWaitIdle;
     decltype(::vkCreateRenderPass)                       *_vkCreateRenderPass;
     decltype(::vkCmdBeginRenderPass)                     *_vkCmdBeginRenderPass;
     decltype(::vkCmdEndRenderPass)                       *_vkCmdEndRenderPass;
     decltype(::vkDestroyRenderPass)                      *_vkDestroyRenderPass;
-    decltype(::vkCmdCopyImage)                           *_vkCmdCopyImage;
-    decltype(::vkGetImageSubresourceLayout)              *_vkGetImageSubresourceLayout;
+    decltype(::vkCmdCopyImageToBuffer)                   *_vkCmdCopyImageToBuffer;
     decltype(::vkCreateSemaphore)                        *_vkCreateSemaphore;
     decltype(::vkDestroySemaphore)                       *_vkDestroySemaphore;
     decltype(::vkCreateBuffer)                           *_vkCreateBuffer;
@@ -180,6 +286,7 @@ private:
     decltype(::vkFlushMappedMemoryRanges)                *_vkFlushMappedMemoryRanges;
     decltype(::vkBindBufferMemory)                       *_vkBindBufferMemory;
     decltype(::vkCmdCopyBufferToImage)                   *_vkCmdCopyBufferToImage;
+    decltype(::vkCmdBlitImage)                           *_vkCmdBlitImage;
     decltype(::vkBindImageMemory)                        *_vkBindImageMemory;
     decltype(::vkCreateCommandPool)                      *_vkCreateCommandPool;
     decltype(::vkResetCommandPool)                       *_vkResetCommandPool;
@@ -202,6 +309,7 @@ private:
     decltype(::vkDestroyFramebuffer)                     *_vkDestroyFramebuffer;
     decltype(::vkCreateFence)                            *_vkCreateFence;
     decltype(::vkWaitForFences)                          *_vkWaitForFences;
+    decltype(::vkGetFenceStatus)                         *_vkGetFenceStatus;
     decltype(::vkResetFences)                            *_vkResetFences;
     decltype(::vkDestroyFence)                           *_vkDestroyFence;
     decltype(::vkCreateDescriptorPool)                   *_vkCreateDescriptorPool;
@@ -210,7 +318,6 @@ private:
     decltype(::vkDestroyDescriptorSetLayout)             *_vkDestroyDescriptorSetLayout;
     decltype(::vkAllocateDescriptorSets)                 *_vkAllocateDescriptorSets;
     decltype(::vkUpdateDescriptorSets)                   *_vkUpdateDescriptorSets;
-    decltype(::vkFreeDescriptorSets)                     *_vkFreeDescriptorSets;
     decltype(::vkGetBufferMemoryRequirements)            *_vkGetBufferMemoryRequirements;
     decltype(::vkGetImageMemoryRequirements)             *_vkGetImageMemoryRequirements;
     decltype(::vkEnumeratePhysicalDevices)               *_vkEnumeratePhysicalDevices;
@@ -218,6 +325,7 @@ private:
     decltype(::vkGetPhysicalDeviceProperties)            *_vkGetPhysicalDeviceProperties;
     decltype(::vkGetPhysicalDeviceQueueFamilyProperties) *_vkGetPhysicalDeviceQueueFamilyProperties;
     decltype(::vkGetPhysicalDeviceMemoryProperties)      *_vkGetPhysicalDeviceMemoryProperties;
+    decltype(::vkGetPhysicalDeviceFormatProperties)      *_vkGetPhysicalDeviceFormatProperties;
     decltype(::vkEnumerateDeviceExtensionProperties)     *_vkEnumerateDeviceExtensionProperties;
 
 public:
@@ -232,6 +340,7 @@ public:
     static VulkanHook_t* Inst();
     virtual const char* GetLibraryName() const;
     virtual RendererHookType_t GetRendererHookType() const;
+    virtual bool GetTextureMemoryStats(RendererTextureMemoryStats_t* stats);
     void LoadFunctions(
         std::function<void*(const char*)> vkLoader,
         decltype(::vkAcquireNextImageKHR)* vkAcquireNextImageKHR,
@@ -240,9 +349,11 @@ public:
         decltype(::vkCreateSwapchainKHR)* vkCreateSwapchainKHR,
         decltype(::vkDestroyDevice)* vkDestroyDevice);
 
-    virtual std::weak_ptr<RendererTexture_t> AllocImageResource();
+    virtual RendererTextureHandle_t AllocImageResource();
+    virtual bool IsResourceFormatSupported(ResourceFormat_t format, uint32_t width, uint32_t height);
     virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter);
-    virtual void ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource);
+    virtual bool UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter);
+    virtual void ReleaseImageResource(RendererTextureHandle_t resource);
 };
 
 }// namespace InGameOverlay
\ No newline at end of file
@@ -48,9 +48,7 @@ private:
     bool _Hooked;
     bool _NSViewHooked;
     bool _Initialized;
-    std::set<std::shared_ptr<RendererTexture_t>> _ImageResources;
     std::vector<RendererTextureLoadParameter_t> _ImageResourcesToLoad;
-    std::vector<RendererTextureReleaseParameter_t> _ImageResourcesToRelease;
     id<MTLDevice> _MetalDevice;
     std::vector<RenderPass_t> _RenderPass;
     
@@ -89,9 +87,9 @@ public:
     virtual RendererHookType_t GetRendererHookType() const;
     void LoadFunctions(Method MTLCommandBufferRenderCommandEncoderWithDescriptor, Method RenderCommandEncoderEndEncoding);
 
-    virtual std::weak_ptr<RendererTexture_t> AllocImageResource();
+    virtual RendererTextureHandle_t AllocImageResource();
     virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter);
-    virtual void ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource);
+    virtual void ReleaseImageResource(RendererTextureHandle_t resource);
 };
 
 }// namespace InGameOverlay
\ No newline at end of file
@@ -84,7 +84,7 @@ void MetalHook_t::_ResetRenderState()
         //NSViewHook_t::Inst()->_ResetRenderState();
         //ImGui::DestroyContext();
 
-        _ImageResources.clear();
+        _ClearTextures();
 
         _MetalDevice = nil;
         
@@ -123,7 +123,9 @@ void MetalHook_t::_PrepareForOverlay(RenderPass_t& renderPass)
         ++_CurrentFrame;
         ImGui::NewFrame();
 
+        _ProcessResourceCommands();
         OverlayProc();
+        _ProcessPreloads();
 
         _LoadResources();
         _ReleaseResources();
@@ -144,7 +146,9 @@ void MetalHook_t::_LoadResources()
 
 void MetalHook_t::_ReleaseResources()
 {
-
+    // The command buffers retain the textures they use, only the frame being recorded can still draw them.
+    _SetCompletedFrame(_CurrentFrame - 1);
+    _ReleaseRetiredTextures();
 }
 
 void MetalHook_t::_HandleScreenshot()
@@ -249,9 +253,9 @@ void MetalHook_t::LoadFunctions(Method MTLCommandBufferRenderCommandEncoderWithD
     _MTLRenderCommandEncoderEndEncodingMethod = RenderCommandEncoderEndEncoding;
 }
 
-std::weak_ptr<RendererTexture_t> MetalHook_t::AllocImageResource()
+RendererTextureHandle_t MetalHook_t::AllocImageResource()
 {
-    return std::shared_ptr<RendererTexture_t>();
+    return RendererTextureHandle_t{};
 }
 
 void MetalHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParameter)
@@ -259,22 +263,11 @@ void MetalHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParamete
     _ImageResourcesToLoad.emplace_back(loadParameter);
 }
 
-void MetalHook_t::ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource)
+void MetalHook_t::ReleaseImageResource(RendererTextureHandle_t resource)
 {
-    auto ptr = resource.lock();
+    auto ptr = _RemoveTexture(resource);
     if (ptr)
-    {
-        auto it = _ImageResources.find(ptr);
-        if (it != _ImageResources.end())
-        {
-            _ImageResources.erase(it);
-            _ImageResourcesToRelease.emplace_back(RendererTextureReleaseParameter_t
-            {
-                std::move(ptr),
-                _CurrentFrame
-            });
-        }
-    }
+        _RetireTexture(std::move(ptr));
 }
 
 }// namespace InGameOverlay
\ No newline at end of file
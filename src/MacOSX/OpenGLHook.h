@@ -58,9 +58,8 @@ private:
     bool _NSViewHooked;
     bool _Initialized;
     OpenGLDriver_t _OpenGLDriver;
-    std::set<std::shared_ptr<RendererTexture_t>> _ImageResources;
     std::vector<RendererTextureLoadParameter_t> _ImageResourcesToLoad;
-    std::vector<RendererTextureReleaseParameter_t> _ImageResourcesToRelease;
+    std::vector<RendererTextureUpdateParameter_t> _ImageResourcesToUpdate;
     void* _ImGuiFontAtlas;
 
     // Functions
@@ -94,9 +93,10 @@ public:
     virtual RendererHookType_t GetRendererHookType() const;
     void LoadFunctions(Method openGLFlushBufferMethod, decltype(::CGLFlushDrawable)* pfnCGLFlushDrawable);
 
-    virtual std::weak_ptr<RendererTexture_t> AllocImageResource();
+    virtual RendererTextureHandle_t AllocImageResource();
     virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter);
-    virtual void ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource);
+    virtual bool UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter);
+    virtual void ReleaseImageResource(RendererTextureHandle_t resource);
 };
 
 }// namespace InGameOverlay
\ No newline at end of file
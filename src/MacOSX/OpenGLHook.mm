@@ -106,7 +106,7 @@ void OpenGLHook_t::_ResetRenderState()
         //NSViewHook_t::Inst()->_ResetRenderState();
         //ImGui::DestroyContext();
 
-        _ImageResources.clear();
+        _ClearTextures();
 
         _Initialized = false;
     }
@@ -163,7 +163,9 @@ void OpenGLHook_t::_PrepareForOverlay()
         ++_CurrentFrame;
         ImGui::NewFrame();
 
+        _ProcessResourceCommands();
         OverlayProc();
+        _ProcessPreloads();
 
         _LoadResources();
         _ReleaseResources();
@@ -179,7 +181,7 @@ void OpenGLHook_t::_PrepareForOverlay()
 
 void OpenGLHook_t::_LoadResources()
 {
-    if (_ImageResourcesToLoad.empty())
+    if (_ImageResourcesToLoad.empty() && _ImageResourcesToUpdate.empty())
         return;
 
     // Save old texture id
@@ -196,12 +198,13 @@ void OpenGLHook_t::_LoadResources()
 
     std::vector<ValidTexture_t> validResources;
 
-    const auto loadParameterCount = _ImageResourcesToLoad.size() > _BatchSize ? _BatchSize : _ImageResourcesToLoad.size();
+    const auto loadParameterCount = _BeginLoadBatch(_ImageResourcesToLoad);
+    uint64_t loadedBytes = 0;
 
     for (size_t i = 0; i < loadParameterCount; ++i)
     {
         auto& param = _ImageResourcesToLoad[i];
-        auto r = param.Resource.lock();
+        auto r = _GetTexture(param.Resource);
         if (!r) continue;
 
         validResources.push_back(ValidTexture_t{
@@ -210,6 +213,8 @@ void OpenGLHook_t::_LoadResources()
             param.Width,
             param.Height
         });
+
+        loadedBytes += uint64_t(param.Width) * param.Height * 4;
     }
 
     if (!validResources.empty())
@@ -227,19 +232,35 @@ void OpenGLHook_t::_LoadResources()
             glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex.Width, tex.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, tex.Data);
 
-            tex.Resource->LoadStatus = RendererTextureStatus_e::Loaded;
+            _SetTextureLoadStatus(tex.Resource->Handle, RendererTextureStatus_e::Loaded);
         }
     }
 
+    for (auto& param : _ImageResourcesToUpdate)
+    {
+        auto textureSlot = GetTextureSlot(param.Resource);
+        if (textureSlot == nullptr || textureSlot->LoadStatus != RendererTextureStatus_e::Loaded) continue;
+        auto r = _GetTexture(param.Resource);
+
+        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(r->ImGuiTextureId));
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, param.X, param.Y, param.Width, param.Height, GL_RGBA, GL_UNSIGNED_BYTE, param.Data.data());
+    }
+    _ImageResourcesToUpdate.clear();
+
     glBindTexture(GL_TEXTURE_2D, oldTex);
 
+    _EndLoadBatch(loadedBytes);
+
     _ImageResourcesToLoad.erase(_ImageResourcesToLoad.begin(),
         _ImageResourcesToLoad.begin() + loadParameterCount);
 }
 
 void OpenGLHook_t::_ReleaseResources()
 {
-    _ImageResourcesToRelease.clear();
+    // The driver keeps the deleted textures alive while the submitted commands use them, only the frame being recorded can still draw them.
+    _SetCompletedFrame(_CurrentFrame - 1);
+    _ReleaseRetiredTextures();
 }
 
 void OpenGLHook_t::_HandleScreenshot()
@@ -346,12 +367,12 @@ void OpenGLHook_t::LoadFunctions(Method openGLFlushBufferMethod, decltype(::CGLF
     _CGLFlushDrawable = pfnCGLFlushDrawable;
 }
 
-std::weak_ptr<RendererTexture_t> OpenGLHook_t::AllocImageResource()
+RendererTextureHandle_t OpenGLHook_t::AllocImageResource()
 {
     GLuint texture = 0;
     glGenTextures(1, &texture);
     if (glGetError() != GL_NO_ERROR)
-        return std::weak_ptr<RendererTexture_t>{};
+        return RendererTextureHandle_t{};
 
     auto ptr = std::shared_ptr<RendererTexture_t>(new RendererTexture_t(), [](RendererTexture_t* handle)
     {
@@ -364,9 +385,7 @@ std::weak_ptr<RendererTexture_t> OpenGLHook_t::AllocImageResource()
     });
     ptr->ImGuiTextureId = static_cast<uint64_t>(texture);
 
-    _ImageResources.emplace(ptr);
-
-    return ptr;
+    return _InsertTexture(std::move(ptr));
 }
 
 void OpenGLHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParameter)
@@ -374,22 +393,17 @@ void OpenGLHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParamet
     _ImageResourcesToLoad.emplace_back(loadParameter);
 }
 
-void OpenGLHook_t::ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource)
+bool OpenGLHook_t::UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter)
 {
-    auto ptr = resource.lock();
+    _ImageResourcesToUpdate.emplace_back(std::move(updateParameter));
+    return true;
+}
+
+void OpenGLHook_t::ReleaseImageResource(RendererTextureHandle_t resource)
+{
+    auto ptr = _RemoveTexture(resource);
     if (ptr)
-    {
-        auto it = _ImageResources.find(ptr);
-        if (it != _ImageResources.end())
-        {
-            _ImageResources.erase(it);
-            _ImageResourcesToRelease.emplace_back(RendererTextureReleaseParameter_t
-            {
-                std::move(ptr),
-                _CurrentFrame
-            });
-        }
-    }
+        _RetireTexture(std::move(ptr));
 }
 
 }// namespace InGameOverlay
\ No newline at end of file
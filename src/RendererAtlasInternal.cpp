@@ -0,0 +1,565 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "RendererHookInternal.h"
+#include "RendererAtlasInternal.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace InGameOverlay {
+
+RendererAtlasPage_t::RendererAtlasPage_t(RendererHookInternal_t* rendererHook) :
+    _RendererHook(rendererHook),
+    _Pixels(std::make_shared<std::vector<uint32_t>>(size_t(MinSize) * MinSize, 0)),
+    _Size(MinSize),
+    _NextShelfY(0),
+    _UsedArea(0),
+    _FreedArea(0),
+    _Generation(0),
+    _LoadingGeneration(0),
+    _LoadingSize(0),
+    _LoadedGeneration(0),
+    _LoadedSize(0),
+    _Reload(true)
+{
+}
+
+bool RendererAtlasPage_t::_PlaceRect(uint32_t width, uint32_t height, RendererAtlasRect_t& rect)
+{
+    const uint32_t paddedWidth = width + Padding * 2;
+    const uint32_t paddedHeight = height + Padding * 2;
+
+    // Best fit: the lowest shelf that can hold the image.
+    Shelf_t* shelf = nullptr;
+    for (auto& s : _Shelves)
+    {
+        if (s.Height >= paddedHeight && s.NextX + paddedWidth <= _Size && (shelf == nullptr || s.Height < shelf->Height))
+            shelf = &s;
+    }
+
+    if (shelf == nullptr)
+    {
+        if (paddedWidth > _Size || _NextShelfY + paddedHeight > _Size)
+            return false;
+
+        _Shelves.emplace_back(Shelf_t{ _NextShelfY, paddedHeight, 0 });
+        _NextShelfY += paddedHeight;
+        shelf = &_Shelves.back();
+    }
+
+    rect.X = shelf->NextX + Padding;
+    rect.Y = shelf->Y + Padding;
+    rect.Width = width;
+    rect.Height = height;
+
+    shelf->NextX += paddedWidth;
+    _UsedArea += uint64_t(paddedWidth) * paddedHeight;
+    return true;
+}
+
+void RendererAtlasPage_t::_Resize(uint32_t size)
+{
+    auto pixels = std::make_shared<std::vector<uint32_t>>(size_t(size) * size, 0);
+    const uint32_t copySize = std::min(size, _Size);
+    for (uint32_t y = 0; y < copySize; ++y)
+        memcpy(pixels->data() + size_t(y) * size, _Pixels->data() + size_t(y) * _Size, copySize * sizeof(uint32_t));
+
+    // The pending load still references the old buffer.
+    _Pixels = std::move(pixels);
+    _Size = size;
+    _DirtyRects.clear();
+    _Reload = true;
+    ++_Generation;
+}
+
+void RendererAtlasPage_t::_AddDirtyRect(RendererAtlasRect_t const& rect)
+{
+    // Merge the rects that overlap, an image updated several times between two frames is sent once.
+    for (auto& dirty : _DirtyRects)
+    {
+        if (rect.X < dirty.X + dirty.Width && dirty.X < rect.X + rect.Width &&
+            rect.Y < dirty.Y + dirty.Height && dirty.Y < rect.Y + rect.Height)
+        {
+            const uint32_t right = std::max(rect.X + rect.Width, dirty.X + dirty.Width);
+            const uint32_t bottom = std::max(rect.Y + rect.Height, dirty.Y + dirty.Height);
+            dirty.X = std::min(rect.X, dirty.X);
+            dirty.Y = std::min(rect.Y, dirty.Y);
+            dirty.Width = right - dirty.X;
+            dirty.Height = bottom - dirty.Y;
+            return;
+        }
+    }
+
+    _DirtyRects.emplace_back(rect);
+}
+
+bool RendererAtlasPage_t::_UpdateDirtyRects(RendererHookInternal_t* rendererHook)
+{
+    for (auto const& dirty : _DirtyRects)
+    {
+        const size_t rowSize = size_t(dirty.Width) * sizeof(uint32_t);
+
+        RendererTextureUpdateParameter_t updateParameter;
+        updateParameter.Resource = _Texture;
+        updateParameter.X = dirty.X;
+        updateParameter.Y = dirty.Y;
+        updateParameter.Width = dirty.Width;
+        updateParameter.Height = dirty.Height;
+        updateParameter.Data.resize(rowSize * dirty.Height);
+        for (uint32_t y = 0; y < dirty.Height; ++y)
+            memcpy(updateParameter.Data.data() + rowSize * y, _Pixels->data() + size_t(dirty.Y + y) * _Size + dirty.X, rowSize);
+
+        if (!rendererHook->UpdateImageResource(updateParameter))
+            return false;
+    }
+
+    _DirtyRects.clear();
+    return true;
+}
+
+bool RendererAtlasPage_t::_IsLoading() const
+{
+    auto r = _RendererHook->GetTextureSlot(_Texture);
+    return r != nullptr && r->LoadStatus == RendererTextureStatus_e::Loading;
+}
+
+bool RendererAtlasPage_t::Insert(uint32_t width, uint32_t height, RendererAtlasRect_t& rect)
+{
+    return _PlaceRect(width, height, rect);
+}
+
+void RendererAtlasPage_t::Remove(RendererAtlasRect_t const& rect)
+{
+    _FreedArea += uint64_t(rect.Width + Padding * 2) * (rect.Height + Padding * 2);
+
+    if (Entries.empty())
+    {
+        _Shelves.clear();
+        _NextShelfY = 0;
+        _UsedArea = 0;
+        _FreedArea = 0;
+    }
+}
+
+bool RendererAtlasPage_t::Grow()
+{
+    if (_Size >= MaxSize)
+        return false;
+
+    // The placed images keep their position, only their texture coordinates change.
+    _Resize(_Size * 2);
+    return true;
+}
+
+bool RendererAtlasPage_t::Repack()
+{
+    // The images would move in the middle of a load, wait for it.
+    if (_IsLoading())
+        return false;
+
+    auto entries = Entries;
+    std::sort(entries.begin(), entries.end(), [](RendererAtlasedResourceInternal_t* l, RendererAtlasedResourceInternal_t* r)
+    {
+        return l->Rect().Height > r->Rect().Height;
+    });
+
+    auto shelves = std::move(_Shelves);
+    const auto nextShelfY = _NextShelfY;
+    const auto usedArea = _UsedArea;
+
+    _Shelves.clear();
+    _NextShelfY = 0;
+    _UsedArea = 0;
+
+    std::vector<RendererAtlasRect_t> rects(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        if (!_PlaceRect(entries[i]->Rect().Width, entries[i]->Rect().Height, rects[i]))
+        {
+            _Shelves = std::move(shelves);
+            _NextShelfY = nextShelfY;
+            _UsedArea = usedArea;
+            return false;
+        }
+    }
+
+    auto pixels = std::make_shared<std::vector<uint32_t>>(size_t(_Size) * _Size, 0);
+    ++_Generation;
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        auto const& from = entries[i]->Rect();
+        auto const& to = rects[i];
+        for (uint32_t y = 0; y < from.Height + Padding * 2; ++y)
+        {
+            memcpy(
+                pixels->data() + size_t(to.Y - Padding + y) * _Size + to.X - Padding,
+                _Pixels->data() + size_t(from.Y - Padding + y) * _Size + from.X - Padding,
+                (from.Width + Padding * 2) * sizeof(uint32_t));
+        }
+
+        entries[i]->MoveRect(to, _Generation);
+    }
+
+    _Pixels = std::move(pixels);
+    _FreedArea = 0;
+    _DirtyRects.clear();
+    _Reload = true;
+    return true;
+}
+
+void RendererAtlasPage_t::_Extrude(RendererAtlasRect_t const& rect)
+{
+    auto pixels = _Pixels->data();
+
+    // Fill the padding with the image edges.
+    for (uint32_t y = rect.Y; y < rect.Y + rect.Height; ++y)
+    {
+        uint32_t* row = pixels + size_t(y) * _Size;
+        for (uint32_t x = 1; x <= Padding; ++x)
+        {
+            row[rect.X - x] = row[rect.X];
+            row[rect.X + rect.Width - 1 + x] = row[rect.X + rect.Width - 1];
+        }
+    }
+
+    const size_t paddedRowSize = (rect.Width + Padding * 2) * sizeof(uint32_t);
+    for (uint32_t y = 1; y <= Padding; ++y)
+    {
+        memcpy(pixels + size_t(rect.Y - y) * _Size + rect.X - Padding, pixels + size_t(rect.Y) * _Size + rect.X - Padding, paddedRowSize);
+        memcpy(pixels + size_t(rect.Y + rect.Height - 1 + y) * _Size + rect.X - Padding, pixels + size_t(rect.Y + rect.Height - 1) * _Size + rect.X - Padding, paddedRowSize);
+    }
+}
+
+void RendererAtlasPage_t::Write(RendererAtlasRect_t const& rect, const void* data)
+{
+    WriteRegion(rect, 0, 0, rect.Width, rect.Height, data, rect.Width * sizeof(uint32_t));
+}
+
+void RendererAtlasPage_t::WriteRegion(RendererAtlasRect_t const& rect, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t pitch)
+{
+    auto src = reinterpret_cast<const uint8_t*>(data);
+    auto dst = _Pixels->data() + size_t(rect.Y + y) * _Size + rect.X + x;
+
+    for (uint32_t i = 0; i < height; ++i)
+        memcpy(dst + size_t(i) * _Size, src + size_t(i) * pitch, width * sizeof(uint32_t));
+
+    _Extrude(rect);
+
+    // The region and the padding the extrusion changed next to it.
+    _AddDirtyRect(RendererAtlasRect_t{ rect.X + x - Padding, rect.Y + y - Padding, width + Padding * 2, height + Padding * 2 });
+    ++_Generation;
+}
+
+uint64_t RendererAtlasPage_t::Generation() const
+{
+    return _Generation;
+}
+
+uint64_t RendererAtlasPage_t::LoadedGeneration() const
+{
+    return _LoadedGeneration;
+}
+
+uint32_t RendererAtlasPage_t::LoadedSize() const
+{
+    return _LoadedSize;
+}
+
+bool RendererAtlasPage_t::IsEmpty() const
+{
+    return Entries.empty();
+}
+
+bool RendererAtlasPage_t::ShouldRepack() const
+{
+    return _FreedArea != 0 && _FreedArea * 4 >= _UsedArea && !_IsLoading();
+}
+
+uint64_t RendererAtlasPage_t::GetTextureId(RendererHookInternal_t* rendererHook)
+{
+    auto r = rendererHook->GetTextureSlot(_Texture);
+
+    // Only some images changed, update them in the loaded texture.
+    if (r != nullptr && r->LoadStatus == RendererTextureStatus_e::Loaded && _LoadingGeneration != _Generation && !_Reload)
+    {
+        if (_UpdateDirtyRects(rendererHook))
+            _LoadingGeneration = _Generation;
+        else
+            _Reload = true;
+    }
+
+    if (r == nullptr ||
+        r->LoadStatus == RendererTextureStatus_e::NotLoaded ||
+        (r->LoadStatus == RendererTextureStatus_e::Loaded && _LoadingGeneration != _Generation))
+    {
+        if (r == nullptr || r->LoadStatus == RendererTextureStatus_e::Loaded)
+        {
+            // Keep the current texture until the new one is loaded.
+            if (r != nullptr)
+            {
+                rendererHook->ReleaseImageResource(_OldTexture);
+                _OldTexture = _Texture;
+            }
+
+            _Texture = rendererHook->AllocImageResource();
+            r = rendererHook->GetTextureSlot(_Texture);
+        }
+
+        if (r != nullptr)
+        {
+            _LoadingPixels = _Pixels;
+            _LoadingGeneration = _Generation;
+            _LoadingSize = _Size;
+            // The load reads the current pixels, the rects written until it is done are updated after.
+            _DirtyRects.clear();
+            _Reload = false;
+
+            RendererTextureLoadParameter_t loadParameter;
+            loadParameter.Resource = _Texture;
+            loadParameter.Data = _LoadingPixels->data();
+            loadParameter.Height = _Size;
+            loadParameter.Width = _Size;
+            r->LoadStatus = RendererTextureStatus_e::Loading;
+            rendererHook->LoadImageResource(loadParameter);
+        }
+    }
+
+    if (r != nullptr && r->LoadStatus == RendererTextureStatus_e::Loaded)
+    {
+        if (rendererHook->GetTextureSlot(_OldTexture) != nullptr)
+        {
+            rendererHook->ReleaseImageResource(_OldTexture);
+            _OldTexture = RendererTextureHandle_t{};
+        }
+
+        _LoadingPixels.reset();
+        _LoadedGeneration = _LoadingGeneration;
+        _LoadedSize = _LoadingSize;
+        return r->ImGuiTextureId;
+    }
+
+    auto old = rendererHook->GetTextureSlot(_OldTexture);
+    return old != nullptr ? old->ImGuiTextureId : 0;
+}
+
+void RendererAtlasPage_t::Release(RendererHookInternal_t* rendererHook)
+{
+    rendererHook->ReleaseImageResource(_OldTexture);
+    rendererHook->ReleaseImageResource(_Texture);
+    _OldTexture = RendererTextureHandle_t{};
+    _Texture = RendererTextureHandle_t{};
+}
+
+RendererAtlasedResourceInternal_t::RendererAtlasedResourceInternal_t(RendererHookInternal_t* rendererHook) noexcept :
+    RendererResourceInternal_t(rendererHook),
+    _Page(nullptr),
+    _Generation(0),
+    _Displayed(false)
+{
+}
+
+RendererAtlasedResourceInternal_t::~RendererAtlasedResourceInternal_t()
+{
+    _RemoveFromPage();
+}
+
+bool RendererAtlasedResourceInternal_t::_IsAtlased() const
+{
+    return _Page != nullptr || (_Format == ResourceFormat_t::R8G8B8A8 &&
+        _RendererResource.Width != 0 && _RendererResource.Width <= RendererAtlasPage_t::MaxImageSize &&
+        _RendererResource.Height != 0 && _RendererResource.Height <= RendererAtlasPage_t::MaxImageSize);
+}
+
+void RendererAtlasedResourceInternal_t::_RemoveFromPage()
+{
+    if (_Page != nullptr)
+    {
+        _RendererHook->AtlasRemove(_Page, this);
+        _Page = nullptr;
+    }
+    _Displayed = false;
+}
+
+bool RendererAtlasedResourceInternal_t::IsLoaded() const
+{
+    return _IsAtlased()
+        ? _Displayed
+        : RendererResourceInternal_t::IsLoaded();
+}
+
+uint64_t RendererAtlasedResourceInternal_t::GetResourceId()
+{
+    if (!_IsAtlased())
+        return RendererResourceInternal_t::GetResourceId();
+
+    if (_Page == nullptr)
+    {
+        if (_Data == nullptr)
+            return 0;
+
+        _Page = _RendererHook->AtlasInsert(this, _RendererResource.Width, _RendererResource.Height, _Rect);
+        if (_Page == nullptr)
+            return 0;
+
+        _Page->Write(_Rect, _Data);
+        _Generation = _Page->Generation();
+    }
+
+    const auto id = _Page->GetTextureId(_RendererHook);
+    if (_Page->LoadedGeneration() >= _Generation)
+    {
+        _DisplayedRect = _Rect;
+        _Displayed = true;
+        // The page keeps its own copy of the pixels.
+        DataLoaded();
+    }
+
+    return _Displayed ? id : 0;
+}
+
+uint32_t RendererAtlasedResourceInternal_t::Width() const
+{
+    return _IsAtlased()
+        ? _RendererResource.Width
+        : RendererResourceInternal_t::Width();
+}
+
+uint32_t RendererAtlasedResourceInternal_t::Height() const
+{
+    return _IsAtlased()
+        ? _RendererResource.Height
+        : RendererResourceInternal_t::Height();
+}
+
+ResourceUV_t RendererAtlasedResourceInternal_t::GetResourceUV() const
+{
+    if (!_Displayed || _Page == nullptr || _Page->LoadedSize() == 0)
+        return RendererResourceInternal_t::GetResourceUV();
+
+    const float size = float(_Page->LoadedSize());
+    return ResourceUV_t{
+        _DisplayedRect.X / size,
+        _DisplayedRect.Y / size,
+        (_DisplayedRect.X + _DisplayedRect.Width) / size,
+        (_DisplayedRect.Y + _DisplayedRect.Height) / size,
+    };
+}
+
+void RendererAtlasedResourceInternal_t::AttachResource(const void* data, uint32_t width, uint32_t height)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::Attach, nullptr, data, width, height }, true))
+        return;
+
+    if (width == 0 || width > RendererAtlasPage_t::MaxImageSize || height == 0 || height > RendererAtlasPage_t::MaxImageSize)
+    {
+        _RemoveFromPage();
+        RendererResourceInternal_t::AttachResource(data, width, height);
+        return;
+    }
+
+    // Drop the texture of a previous big image.
+    RendererResourceInternal_t::Unload(false);
+
+    if (_Page != nullptr && (_Rect.Width != width || _Rect.Height != height))
+        _RemoveFromPage();
+
+    _Data = data;
+    _DataOwner.reset();
+    _ReleaseDataOnLoad = false;
+    _Format = ResourceFormat_t::R8G8B8A8;
+    _RendererResource.Width = width;
+    _RendererResource.Height = height;
+
+    // Same size, update the pixels in place, the current ones are displayed until the page is loaded again.
+    if (_Page != nullptr && _Data != nullptr)
+    {
+        _Page->Write(_Rect, _Data);
+        _Generation = _Page->Generation();
+    }
+}
+
+void RendererAtlasedResourceInternal_t::AttachResource(const void* data, uint32_t width, uint32_t height, ResourceFormat_t format)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::AttachFormatted, nullptr, data, width, height, format }, true))
+        return;
+
+    if (format == ResourceFormat_t::R8G8B8A8)
+    {
+        AttachResource(data, width, height);
+        return;
+    }
+
+    // The pages are RGBA, an image in another format gets its own texture.
+    _RemoveFromPage();
+    RendererResourceInternal_t::AttachResource(data, width, height, format);
+}
+
+void RendererAtlasedResourceInternal_t::UpdateRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t pitch)
+{
+    if (!_IsAtlased())
+    {
+        RendererResourceInternal_t::UpdateRegion(x, y, width, height, data, pitch);
+        return;
+    }
+
+    // Written so x + width can't wrap around.
+    if (_Page == nullptr || data == nullptr || width == 0 || height == 0 ||
+        x > _Rect.Width || width > _Rect.Width - x || y > _Rect.Height || height > _Rect.Height - y)
+        return;
+
+    // The page texture is shared, its pixels are updated and the page is loaded again.
+    _Page->WriteRegion(_Rect, x, y, width, height, data, pitch == 0 ? width * 4 : pitch);
+    _Generation = _Page->Generation();
+}
+
+void RendererAtlasedResourceInternal_t::Unload(bool clearAttachedResource)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::Unload, nullptr, nullptr, 0, 0, ResourceFormat_t::R8G8B8A8, nullptr, nullptr, clearAttachedResource }, true))
+        return;
+
+    if (!_IsAtlased())
+    {
+        RendererResourceInternal_t::Unload(clearAttachedResource);
+        return;
+    }
+
+    _RemoveFromPage();
+
+    if (clearAttachedResource)
+    {
+        ClearAttachedResource();
+        _RendererResource.Reset();
+    }
+}
+
+void RendererAtlasedResourceInternal_t::MoveRect(RendererAtlasRect_t const& rect, uint64_t generation)
+{
+    _Rect = rect;
+    _Generation = generation;
+}
+
+RendererAtlasRect_t const& RendererAtlasedResourceInternal_t::Rect() const
+{
+    return _Rect;
+}
+
+}
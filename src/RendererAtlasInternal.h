@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "RendererResourceInternal.h"
+
+namespace InGameOverlay {
+
+class RendererAtlasedResourceInternal_t;
+
+struct RendererAtlasRect_t
+{
+    uint32_t X = 0;
+    uint32_t Y = 0;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+};
+
+// A shared texture the small resources are packed into with a shelf packer.
+// The page keeps its pixels on the CPU, the changed rects are updated in the loaded texture.
+// The whole texture is only loaded again when the page grows or is repacked, or when the renderer can't update it,
+// the previous texture is still used until the new one is loaded.
+class RendererAtlasPage_t
+{
+    struct Shelf_t
+    {
+        uint32_t Y;
+        uint32_t Height;
+        uint32_t NextX;
+    };
+
+    RendererHookInternal_t* _RendererHook;
+    std::shared_ptr<std::vector<uint32_t>> _Pixels;
+    // The buffer referenced by the pending load, kept alive until it is done.
+    std::shared_ptr<std::vector<uint32_t>> _LoadingPixels;
+    uint32_t _Size;
+    std::vector<Shelf_t> _Shelves;
+    uint32_t _NextShelfY;
+    uint64_t _UsedArea;
+    uint64_t _FreedArea;
+
+    RendererTextureHandle_t _Texture;
+    RendererTextureHandle_t _OldTexture;
+    // Incremented each time the pixels change.
+    uint64_t _Generation;
+    uint64_t _LoadingGeneration;
+    uint32_t _LoadingSize;
+    uint64_t _LoadedGeneration;
+    uint32_t _LoadedSize;
+    // The rects written since the last load, with their padding.
+    std::vector<RendererAtlasRect_t> _DirtyRects;
+    // The layout changed, the texture must be loaded again.
+    bool _Reload;
+
+    bool _PlaceRect(uint32_t width, uint32_t height, RendererAtlasRect_t& rect);
+    void _Extrude(RendererAtlasRect_t const& rect);
+    void _Resize(uint32_t size);
+    void _AddDirtyRect(RendererAtlasRect_t const& rect);
+    bool _UpdateDirtyRects(RendererHookInternal_t* rendererHook);
+    bool _IsLoading() const;
+
+public:
+    constexpr static uint32_t MinSize = 512;
+    constexpr static uint32_t MaxSize = 2048;
+    constexpr static uint32_t MaxImageSize = 256;
+    // Border added around each image, filled with the image edges so the linear filtering doesn't bleed from the neighbours.
+    constexpr static uint32_t Padding = 1;
+
+    std::vector<RendererAtlasedResourceInternal_t*> Entries;
+
+    RendererAtlasPage_t(RendererHookInternal_t* rendererHook);
+
+    bool Insert(uint32_t width, uint32_t height, RendererAtlasRect_t& rect);
+    void Remove(RendererAtlasRect_t const& rect);
+    bool Grow();
+    bool Repack();
+    void Write(RendererAtlasRect_t const& rect, const void* data);
+    void WriteRegion(RendererAtlasRect_t const& rect, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t pitch);
+    uint64_t Generation() const;
+    uint64_t LoadedGeneration() const;
+    uint32_t LoadedSize() const;
+    bool IsEmpty() const;
+    bool ShouldRepack() const;
+
+    uint64_t GetTextureId(RendererHookInternal_t* rendererHook);
+    void Release(RendererHookInternal_t* rendererHook);
+};
+
+class RendererAtlasedResourceInternal_t : public RendererResourceInternal_t
+{
+    RendererAtlasPage_t* _Page;
+    // Where the image is in the page pixels and the page generation that contains it.
+    RendererAtlasRect_t _Rect;
+    uint64_t _Generation;
+    // Where the image is in the page texture currently returned by GetResourceId.
+    RendererAtlasRect_t _DisplayedRect;
+    bool _Displayed;
+
+    bool _IsAtlased() const;
+    void _RemoveFromPage();
+
+public:
+    RendererAtlasedResourceInternal_t(RendererHookInternal_t* rendererHook) noexcept;
+
+    virtual ~RendererAtlasedResourceInternal_t();
+
+    virtual bool IsLoaded() const;
+
+    virtual uint64_t GetResourceId();
+
+    virtual uint32_t Width() const;
+
+    virtual uint32_t Height() const;
+
+    virtual ResourceUV_t GetResourceUV() const;
+
+    using RendererResourceInternal_t::AttachResource;
+
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height);
+
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height, ResourceFormat_t format);
+
+    virtual void UpdateRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t pitch);
+
+    virtual void Unload(bool clearAttachedResource = true);
+
+    void MoveRect(RendererAtlasRect_t const& rect, uint64_t generation);
+
+    RendererAtlasRect_t const& Rect() const;
+};
+
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "RendererHookInternal.h"
+#include "RendererDecoderInternal.h"
+
+#include <algorithm>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_STATIC
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_BMP
+#define STBI_ONLY_TGA
+// The static declarations of the formats left out are never defined, and the decoders compare signed and unsigned sizes.
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+#include "stb/stb_image.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace InGameOverlay {
+
+static constexpr uint32_t MaxDecoderThreads = 2;
+
+static void ReleaseDecodedPixels(void* data, void* /*userParameter*/)
+{
+    stbi_image_free(data);
+}
+
+RendererDecodeJob_t::~RendererDecodeJob_t()
+{
+    if (Pixels != nullptr)
+        stbi_image_free(Pixels);
+}
+
+void* RendererDecodeJob_t::TakePixels()
+{
+    void* pixels = Pixels;
+    Pixels = nullptr;
+    return pixels;
+}
+
+RendererDecoderPool_t::RendererDecoderPool_t() :
+    _Stop(false)
+{
+}
+
+RendererDecoderPool_t::~RendererDecoderPool_t()
+{
+    {
+        std::lock_guard<std::mutex> lk(_Mutex);
+        _Stop = true;
+    }
+    _JobCondition.notify_all();
+
+    for (auto& thread : _Threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+void RendererDecoderPool_t::_WorkerProc()
+{
+    while (true)
+    {
+        std::shared_ptr<RendererDecodeJob_t> job;
+        {
+            std::unique_lock<std::mutex> lk(_Mutex);
+            _JobCondition.wait(lk, [this]() { return _Stop || !_Jobs.empty(); });
+            if (_Stop)
+                return;
+
+            job = std::move(_Jobs.front());
+            _Jobs.pop_front();
+        }
+
+        Decode(*job);
+    }
+}
+
+void RendererDecoderPool_t::Push(std::shared_ptr<RendererDecodeJob_t> job)
+{
+    {
+        std::lock_guard<std::mutex> lk(_Mutex);
+        _Jobs.emplace_back(std::move(job));
+
+        // Start a new thread while the existing ones are busy.
+        const auto maxThreads = std::max(1u, std::min(MaxDecoderThreads, std::thread::hardware_concurrency() / 2));
+        if (_Threads.size() < maxThreads && _Jobs.size() > _Threads.size())
+            _Threads.emplace_back(&RendererDecoderPool_t::_WorkerProc, this);
+    }
+    _JobCondition.notify_one();
+}
+
+void RendererDecoderPool_t::Decode(RendererDecodeJob_t& job)
+{
+    // The resource was deleted or attached to something else before the job started.
+    if (job.Status.load() != RendererDecodeStatus_e::Pending)
+        return;
+
+    int width, height;
+    auto pixels = stbi_load_from_memory(job.EncodedData.data(), static_cast<int>(job.EncodedData.size()), &width, &height, nullptr, 4);
+
+    job.EncodedData.clear();
+    job.EncodedData.shrink_to_fit();
+
+    if (pixels == nullptr)
+    {
+        job.Status = RendererDecodeStatus_e::Failed;
+        return;
+    }
+
+    job.Pixels = pixels;
+    job.Width = static_cast<uint32_t>(width);
+    job.Height = static_cast<uint32_t>(height);
+
+    // Publishes the pixels to the render thread, a cancelled job frees them in its destructor.
+    auto expected = RendererDecodeStatus_e::Pending;
+    job.Status.compare_exchange_strong(expected, RendererDecodeStatus_e::Decoded);
+}
+
+RendererDecodedResourceInternal_t::RendererDecodedResourceInternal_t(RendererHookInternal_t* rendererHook, std::shared_ptr<RendererDecodeJob_t> decodeJob) noexcept :
+    RendererResourceInternal_t(rendererHook),
+    _DecodeJob(std::move(decodeJob))
+{
+}
+
+RendererDecodedResourceInternal_t::~RendererDecodedResourceInternal_t()
+{
+    _CancelDecode();
+}
+
+void RendererDecodedResourceInternal_t::_CancelDecode()
+{
+    if (_DecodeJob != nullptr)
+    {
+        _DecodeJob->Status = RendererDecodeStatus_e::Cancelled;
+        _DecodeJob.reset();
+    }
+}
+
+void RendererDecodedResourceInternal_t::_PollDecode()
+{
+    if (_DecodeJob == nullptr)
+        return;
+
+    switch (_DecodeJob->Status.load())
+    {
+        case RendererDecodeStatus_e::Pending: return;
+
+        case RendererDecodeStatus_e::Decoded:
+        {
+            auto job = std::move(_DecodeJob);
+            // Attached now, a later attachement posted before this frame must replace it.
+            _CallingItself = true;
+            RendererResourceInternal_t::AttachResource(job->TakePixels(), job->Width, job->Height, ReleaseDecodedPixels, nullptr, false);
+            _CallingItself = false;
+        }
+        break;
+
+        default: _DecodeJob.reset();
+    }
+}
+
+bool RendererDecodedResourceInternal_t::HasAttachedResource() const
+{
+    return (_DecodeJob != nullptr && _DecodeJob->Status.load() != RendererDecodeStatus_e::Failed) || RendererResourceInternal_t::HasAttachedResource();
+}
+
+uint64_t RendererDecodedResourceInternal_t::GetResourceId()
+{
+    // The decoded pixels go through the usual load path, the render thread only uploads them.
+    _PollDecode();
+    return RendererResourceInternal_t::GetResourceId();
+}
+
+uint32_t RendererDecodedResourceInternal_t::Width() const
+{
+    if (_DecodeJob != nullptr && _DecodeJob->Status.load() == RendererDecodeStatus_e::Decoded)
+        return _DecodeJob->Width;
+
+    return RendererResourceInternal_t::Width();
+}
+
+uint32_t RendererDecodedResourceInternal_t::Height() const
+{
+    if (_DecodeJob != nullptr && _DecodeJob->Status.load() == RendererDecodeStatus_e::Decoded)
+        return _DecodeJob->Height;
+
+    return RendererResourceInternal_t::Height();
+}
+
+void RendererDecodedResourceInternal_t::AttachResource(const void* data, uint32_t width, uint32_t height)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::Attach, nullptr, data, width, height }, true))
+        return;
+
+    _CancelDecode();
+    RendererResourceInternal_t::AttachResource(data, width, height);
+}
+
+void RendererDecodedResourceInternal_t::AttachResource(const void* data, uint32_t width, uint32_t height, ResourceFormat_t format)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::AttachFormatted, nullptr, data, width, height, format }, true))
+        return;
+
+    _CancelDecode();
+    RendererResourceInternal_t::AttachResource(data, width, height, format);
+}
+
+void RendererDecodedResourceInternal_t::Unload(bool clearAttachedResource)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::Unload, nullptr, nullptr, 0, 0, ResourceFormat_t::R8G8B8A8, nullptr, nullptr, clearAttachedResource }, true))
+        return;
+
+    if (clearAttachedResource)
+        _CancelDecode();
+
+    RendererResourceInternal_t::Unload(clearAttachedResource);
+}
+
+}
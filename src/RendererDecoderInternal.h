@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RendererResourceInternal.h"
+
+namespace InGameOverlay {
+
+enum class RendererDecodeStatus_e
+{
+    Pending,
+    Decoded,
+    Failed,
+    Cancelled,
+};
+
+// Shared between the resource and the decoder threads, the resource can be deleted while the job is decoded.
+struct RendererDecodeJob_t
+{
+    std::vector<uint8_t> EncodedData;
+    std::atomic<RendererDecodeStatus_e> Status{ RendererDecodeStatus_e::Pending };
+    // RGBA pixels allocated by the decoder, valid once Status is Decoded.
+    void* Pixels = nullptr;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+
+    ~RendererDecodeJob_t();
+
+    void* TakePixels();
+};
+
+// A few threads decoding the encoded images off the render thread, they are started with the first job.
+class RendererDecoderPool_t
+{
+    std::mutex _Mutex;
+    std::condition_variable _JobCondition;
+    std::deque<std::shared_ptr<RendererDecodeJob_t>> _Jobs;
+    std::vector<std::thread> _Threads;
+    bool _Stop;
+
+    void _WorkerProc();
+
+public:
+    RendererDecoderPool_t();
+    ~RendererDecoderPool_t();
+
+    void Push(std::shared_ptr<RendererDecodeJob_t> job);
+
+    static void Decode(RendererDecodeJob_t& job);
+};
+
+// A resource created from an encoded image, the decoded pixels are attached and owned once the decoder is done with them.
+class RendererDecodedResourceInternal_t : public RendererResourceInternal_t
+{
+    std::shared_ptr<RendererDecodeJob_t> _DecodeJob;
+
+    void _CancelDecode();
+    void _PollDecode();
+
+public:
+    RendererDecodedResourceInternal_t(RendererHookInternal_t* rendererHook, std::shared_ptr<RendererDecodeJob_t> decodeJob) noexcept;
+
+    virtual ~RendererDecodedResourceInternal_t();
+
+    virtual bool HasAttachedResource() const;
+
+    virtual uint64_t GetResourceId();
+
+    virtual uint32_t Width() const;
+
+    virtual uint32_t Height() const;
+
+    using RendererResourceInternal_t::AttachResource;
+
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height);
+
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height, ResourceFormat_t format);
+
+    virtual void Unload(bool clearAttachedResource = true);
+};
+
+}
@@ -0,0 +1,836 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "RendererFormatInternal.h"
+
+#include <InGameOverlay/ScreenshotConverter.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define INGAMEOVERLAY_FORMAT_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace InGameOverlay {
+
+// Decodes a 4x4 block into 16 RGBA pixels, row major.
+typedef void (*BlockDecoder_t)(const uint8_t* block, uint8_t* pixels);
+
+// Converts pixelCount pixels to RGBA.
+typedef void (*PixelConverter_t)(const void* data, size_t pixelCount, uint8_t* rgba);
+
+static inline uint8_t ClampColor(int32_t value)
+{
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+/////////////////////////////////////////////////////////////
+// BC1 / BC3
+
+static void DecodeBC1Colors(const uint8_t* block, uint8_t* pixels, bool allowTransparent)
+{
+    const uint32_t c0 = block[0] | (block[1] << 8);
+    const uint32_t c1 = block[2] | (block[3] << 8);
+    const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (uint32_t(block[7]) << 24);
+
+    uint8_t colors[4][4];
+    for (int i = 0; i < 2; ++i)
+    {
+        const uint32_t c = i == 0 ? c0 : c1;
+        const uint32_t r = (c >> 11) & 0x1f;
+        const uint32_t g = (c >> 5) & 0x3f;
+        const uint32_t b = c & 0x1f;
+        colors[i][0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+        colors[i][1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+        colors[i][2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        colors[i][3] = 255;
+    }
+
+    for (int c = 0; c < 3; ++c)
+    {
+        if (c0 > c1 || !allowTransparent)
+        {
+            colors[2][c] = static_cast<uint8_t>((2 * colors[0][c] + colors[1][c]) / 3);
+            colors[3][c] = static_cast<uint8_t>((colors[0][c] + 2 * colors[1][c]) / 3);
+        }
+        else
+        {
+            colors[2][c] = static_cast<uint8_t>((colors[0][c] + colors[1][c]) / 2);
+            colors[3][c] = 0;
+        }
+    }
+    colors[2][3] = 255;
+    colors[3][3] = (c0 > c1 || !allowTransparent) ? 255 : 0;
+
+    for (int i = 0; i < 16; ++i)
+        memcpy(pixels + i * 4, colors[(indices >> (i * 2)) & 3], 4);
+}
+
+static void DecodeBC1Block(const uint8_t* block, uint8_t* pixels)
+{
+    DecodeBC1Colors(block, pixels, true);
+}
+
+static void DecodeBC3Block(const uint8_t* block, uint8_t* pixels)
+{
+    DecodeBC1Colors(block + 8, pixels, false);
+
+    const uint32_t a0 = block[0];
+    const uint32_t a1 = block[1];
+    uint8_t alphas[8];
+    alphas[0] = static_cast<uint8_t>(a0);
+    alphas[1] = static_cast<uint8_t>(a1);
+    if (a0 > a1)
+    {
+        for (uint32_t i = 1; i < 7; ++i)
+            alphas[i + 1] = static_cast<uint8_t>(((7 - i) * a0 + i * a1 + 3) / 7);
+    }
+    else
+    {
+        for (uint32_t i = 1; i < 5; ++i)
+            alphas[i + 1] = static_cast<uint8_t>(((5 - i) * a0 + i * a1 + 2) / 5);
+        alphas[6] = 0;
+        alphas[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i)
+        indices |= uint64_t(block[2 + i]) << (8 * i);
+
+    for (int i = 0; i < 16; ++i)
+        pixels[i * 4 + 3] = alphas[(indices >> (i * 3)) & 7];
+}
+
+/////////////////////////////////////////////////////////////
+// BC7
+
+struct BC7Mode_t
+{
+    uint8_t SubsetCount;
+    uint8_t PartitionBits;
+    uint8_t RotationBits;
+    uint8_t IndexSelectionBits;
+    uint8_t ColorBits;
+    uint8_t AlphaBits;
+    uint8_t EndpointPBits;
+    uint8_t SharedPBits;
+    uint8_t IndexBits;
+    uint8_t SecondaryIndexBits;
+};
+
+static constexpr BC7Mode_t BC7Modes[8] = {
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+// Bit i is the subset of the pixel i.
+static constexpr uint16_t BC7Partitions2[64] = {
+    0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80,
+    0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+    0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce,
+    0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+    0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a,
+    0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+    0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c,
+    0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22,
+};
+
+// Bits 2i and 2i+1 are the subset of the pixel i.
+static constexpr uint32_t BC7Partitions3[64] = {
+    0xaa685050, 0x6a5a5040, 0x5a5a4200, 0x5450a0a8, 0xa5a50000, 0xa0a05050, 0x5555a0a0, 0x5a5a5050,
+    0xaa550000, 0xaa555500, 0xaaaa5500, 0x90909090, 0x94949494, 0xa4a4a4a4, 0xa9a59450, 0x2a0a4250,
+    0xa5945040, 0x0a425054, 0xa5a5a500, 0x55a0a0a0, 0xa8a85454, 0x6a6a4040, 0xa4a45000, 0x1a1a0500,
+    0x0050a4a4, 0xaaa59090, 0x14696914, 0x69691400, 0xa08585a0, 0xaa821414, 0x50a4a450, 0x6a5a0200,
+    0xa9a58000, 0x5090a0a8, 0xa8a09050, 0x24242424, 0x00aa5500, 0x24924924, 0x24499224, 0x50a50a50,
+    0x500aa550, 0xaaaa4444, 0x66660000, 0xa5a0a5a0, 0x50a050a0, 0x69286928, 0x44aaaa44, 0x66666600,
+    0xaa444444, 0x54a854a8, 0x95809580, 0x96969600, 0xa85454a8, 0x80959580, 0xaa141414, 0x96960000,
+    0xaaaa1414, 0xa05050a0, 0xa0a5a5a0, 0x96000000, 0x40804080, 0xa9a8a9a8, 0xaaaaaa44, 0x2a4a5254,
+};
+
+// The pixel storing the subset 1 endpoints order of the 2 subsets partitions, with an index bit less.
+static constexpr uint8_t BC7Anchors2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// The pixels storing the subsets 1 and 2 endpoints order of the 3 subsets partitions.
+static constexpr uint8_t BC7Anchors3Subset1[64] = {
+     3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+     3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+     8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+     3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+};
+
+static constexpr uint8_t BC7Anchors3Subset2[64] = {
+    15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+    15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+    15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+    15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+};
+
+static constexpr uint8_t BC7Weights2[4] = { 0, 21, 43, 64 };
+static constexpr uint8_t BC7Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static constexpr uint8_t BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+class BC7BitReader_t
+{
+    const uint8_t* _Data;
+    uint32_t _Position;
+
+public:
+    BC7BitReader_t(const uint8_t* data) :
+        _Data(data),
+        _Position(0)
+    {}
+
+    uint32_t Read(uint32_t bitCount)
+    {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < bitCount; ++i, ++_Position)
+            value |= uint32_t((_Data[_Position >> 3] >> (_Position & 7)) & 1) << i;
+
+        return value;
+    }
+};
+
+static inline uint8_t BC7Interpolate(uint32_t e0, uint32_t e1, uint32_t index, uint32_t indexBits)
+{
+    const uint32_t weight = indexBits == 2 ? BC7Weights2[index] : (indexBits == 3 ? BC7Weights3[index] : BC7Weights4[index]);
+    return static_cast<uint8_t>(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+}
+
+static void DecodeBC7Block(const uint8_t* block, uint8_t* pixels)
+{
+    uint32_t modeIndex = 0;
+    while (modeIndex < 8 && ((block[0] >> modeIndex) & 1) == 0)
+        ++modeIndex;
+
+    // Reserved mode, decoded as transparent black.
+    if (modeIndex == 8)
+    {
+        memset(pixels, 0, 16 * 4);
+        return;
+    }
+
+    const BC7Mode_t& mode = BC7Modes[modeIndex];
+    BC7BitReader_t reader(block);
+    reader.Read(modeIndex + 1);
+
+    const uint32_t partition = reader.Read(mode.PartitionBits);
+    const uint32_t rotation = reader.Read(mode.RotationBits);
+    const uint32_t indexSelection = reader.Read(mode.IndexSelectionBits);
+
+    const uint32_t endpointCount = mode.SubsetCount * 2u;
+    uint32_t endpoints[6][4];
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        for (uint32_t e = 0; e < endpointCount; ++e)
+            endpoints[e][c] = reader.Read(mode.ColorBits);
+    }
+    for (uint32_t e = 0; e < endpointCount; ++e)
+        endpoints[e][3] = mode.AlphaBits != 0 ? reader.Read(mode.AlphaBits) : 255;
+
+    uint32_t pBits[6] = {};
+    if (mode.EndpointPBits != 0)
+    {
+        for (uint32_t e = 0; e < endpointCount; ++e)
+            pBits[e] = reader.Read(1);
+    }
+    else if (mode.SharedPBits != 0)
+    {
+        for (uint32_t s = 0; s < mode.SubsetCount; ++s)
+            pBits[s * 2] = pBits[s * 2 + 1] = reader.Read(1);
+    }
+
+    const bool hasPBits = mode.EndpointPBits != 0 || mode.SharedPBits != 0;
+    for (uint32_t e = 0; e < endpointCount; ++e)
+    {
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            if (c == 3 && mode.AlphaBits == 0)
+                continue;
+
+            uint32_t bits = c == 3 ? mode.AlphaBits : mode.ColorBits;
+            uint32_t value = endpoints[e][c];
+            if (hasPBits)
+            {
+                value = (value << 1) | pBits[e];
+                ++bits;
+            }
+            endpoints[e][c] = ((value << (8 - bits)) | (value >> (2 * bits - 8))) & 0xff;
+        }
+    }
+
+    uint32_t subsets[16];
+    uint32_t anchors[3] = { 0, 0, 0 };
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        subsets[i] = mode.SubsetCount == 1 ? 0 : (mode.SubsetCount == 2
+            ? (BC7Partitions2[partition] >> i) & 1
+            : (BC7Partitions3[partition] >> (i * 2)) & 3);
+    }
+    if (mode.SubsetCount == 2)
+    {
+        anchors[1] = BC7Anchors2[partition];
+    }
+    else if (mode.SubsetCount == 3)
+    {
+        anchors[1] = BC7Anchors3Subset1[partition];
+        anchors[2] = BC7Anchors3Subset2[partition];
+    }
+
+    uint32_t indices[16];
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        const bool isAnchor = i == anchors[subsets[i]];
+        indices[i] = reader.Read(mode.IndexBits - (isAnchor ? 1 : 0));
+    }
+
+    uint32_t secondaryIndices[16] = {};
+    if (mode.SecondaryIndexBits != 0)
+    {
+        for (uint32_t i = 0; i < 16; ++i)
+            secondaryIndices[i] = reader.Read(mode.SecondaryIndexBits - (i == 0 ? 1 : 0));
+    }
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        const uint32_t* e0 = endpoints[subsets[i] * 2];
+        const uint32_t* e1 = endpoints[subsets[i] * 2 + 1];
+        uint8_t* pixel = pixels + i * 4;
+
+        uint32_t colorIndex = indices[i];
+        uint32_t colorIndexBits = mode.IndexBits;
+        uint32_t alphaIndex = indices[i];
+        uint32_t alphaIndexBits = mode.IndexBits;
+        if (mode.SecondaryIndexBits != 0)
+        {
+            if (indexSelection == 0)
+            {
+                alphaIndex = secondaryIndices[i];
+                alphaIndexBits = mode.SecondaryIndexBits;
+            }
+            else
+            {
+                colorIndex = secondaryIndices[i];
+                colorIndexBits = mode.SecondaryIndexBits;
+            }
+        }
+
+        for (uint32_t c = 0; c < 3; ++c)
+            pixel[c] = BC7Interpolate(e0[c], e1[c], colorIndex, colorIndexBits);
+
+        pixel[3] = mode.AlphaBits != 0
+            ? BC7Interpolate(e0[3], e1[3], alphaIndex, alphaIndexBits)
+            : 255;
+
+        if (rotation != 0)
+            std::swap(pixel[3], pixel[rotation - 1]);
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// ETC2
+
+static constexpr int32_t ETC1Modifiers[8][2] = {
+    {  2,   8 },
+    {  5,  17 },
+    {  9,  29 },
+    { 13,  42 },
+    { 18,  60 },
+    { 24,  80 },
+    { 33, 106 },
+    { 47, 183 },
+};
+
+static constexpr int32_t ETC2Distances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+static constexpr int32_t EACModifiers[16][8] = {
+    { -3, -6,  -9, -15, 2, 5, 8, 14 },
+    { -3, -7, -10, -13, 2, 6, 9, 12 },
+    { -2, -5,  -8, -13, 1, 4, 7, 12 },
+    { -2, -4,  -6, -13, 1, 3, 5, 12 },
+    { -3, -6,  -8, -12, 2, 5, 7, 11 },
+    { -3, -7,  -9, -11, 2, 6, 8, 10 },
+    { -4, -7,  -8, -11, 3, 6, 7, 10 },
+    { -3, -5,  -8, -11, 2, 4, 7, 10 },
+    { -2, -6,  -8, -10, 1, 5, 7,  9 },
+    { -2, -5,  -8, -10, 1, 4, 7,  9 },
+    { -2, -4,  -8, -10, 1, 3, 7,  9 },
+    { -2, -5,  -7, -10, 1, 4, 6,  9 },
+    { -3, -4,  -7, -10, 2, 3, 6,  9 },
+    { -1, -2,  -3, -10, 0, 1, 2,  9 },
+    { -4, -6,  -8,  -9, 3, 5, 7,  8 },
+    { -3, -5,  -7,  -9, 2, 4, 6,  8 },
+};
+
+static inline int32_t Expand4(uint32_t value) { return int32_t((value << 4) | value); }
+static inline int32_t Expand5(uint32_t value) { return int32_t((value << 3) | (value >> 2)); }
+static inline int32_t Expand6(uint32_t value) { return int32_t((value << 2) | (value >> 4)); }
+static inline int32_t Expand7(uint32_t value) { return int32_t((value << 1) | (value >> 6)); }
+
+static inline int32_t SignExtend3(uint32_t value) { return (value & 4) ? int32_t(value) - 8 : int32_t(value); }
+
+static void DecodeETC2Colors(const uint8_t* block, uint8_t* pixels)
+{
+    // The pixel indices are stored column major, the most significant bits first.
+    const uint32_t msbs = (block[4] << 8) | block[5];
+    const uint32_t lsbs = (block[6] << 8) | block[7];
+    auto pixelIndex = [msbs, lsbs](uint32_t x, uint32_t y)
+    {
+        const uint32_t bit = x * 4 + y;
+        return (((msbs >> bit) & 1) << 1) | ((lsbs >> bit) & 1);
+    };
+    auto setPixel = [pixels](uint32_t x, uint32_t y, int32_t r, int32_t g, int32_t b)
+    {
+        uint8_t* pixel = pixels + (y * 4 + x) * 4;
+        pixel[0] = ClampColor(r);
+        pixel[1] = ClampColor(g);
+        pixel[2] = ClampColor(b);
+        pixel[3] = 255;
+    };
+
+    const bool differential = (block[3] & 2) != 0;
+    const bool flip = (block[3] & 1) != 0;
+
+    int32_t base[2][3];
+    if (differential)
+    {
+        const int32_t r = block[0] >> 3;
+        const int32_t g = block[1] >> 3;
+        const int32_t b = block[2] >> 3;
+        const int32_t r2 = r + SignExtend3(block[0] & 7);
+        const int32_t g2 = g + SignExtend3(block[1] & 7);
+        const int32_t b2 = b + SignExtend3(block[2] & 7);
+
+        if (r2 < 0 || r2 > 31)
+        {
+            // T mode
+            int32_t paints[4][3];
+            const int32_t c1[3] = {
+                Expand4(((block[0] >> 1) & 0xc) | (block[0] & 3)),
+                Expand4(block[1] >> 4),
+                Expand4(block[1] & 0xf),
+            };
+            const int32_t c2[3] = {
+                Expand4(block[2] >> 4),
+                Expand4(block[2] & 0xf),
+                Expand4(block[3] >> 4),
+            };
+            const int32_t distance = ETC2Distances[(((block[3] >> 2) & 3) << 1) | (block[3] & 1)];
+            for (int c = 0; c < 3; ++c)
+            {
+                paints[0][c] = c1[c];
+                paints[1][c] = c2[c] + distance;
+                paints[2][c] = c2[c];
+                paints[3][c] = c2[c] - distance;
+            }
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    const int32_t* paint = paints[pixelIndex(x, y)];
+                    setPixel(x, y, paint[0], paint[1], paint[2]);
+                }
+            }
+            return;
+        }
+
+        if (g2 < 0 || g2 > 31)
+        {
+            // H mode
+            int32_t paints[4][3];
+            const uint32_t r1 = (block[0] >> 3) & 0xf;
+            const uint32_t g1 = ((block[0] << 1) & 0xe) | ((block[1] >> 4) & 1);
+            const uint32_t b1 = (block[1] & 8) | ((block[1] << 1) & 6) | (block[2] >> 7);
+            const uint32_t r2h = (block[2] >> 3) & 0xf;
+            const uint32_t g2h = ((block[2] << 1) & 0xe) | (block[3] >> 7);
+            const uint32_t b2h = (block[3] >> 3) & 0xf;
+            const int32_t c1[3] = { Expand4(r1), Expand4(g1), Expand4(b1) };
+            const int32_t c2[3] = { Expand4(r2h), Expand4(g2h), Expand4(b2h) };
+            const uint32_t order = ((r1 << 8) | (g1 << 4) | b1) >= ((r2h << 8) | (g2h << 4) | b2h) ? 1 : 0;
+            const int32_t distance = ETC2Distances[(block[3] & 4) | ((block[3] & 1) << 1) | order];
+            for (int c = 0; c < 3; ++c)
+            {
+                paints[0][c] = c1[c] + distance;
+                paints[1][c] = c1[c] - distance;
+                paints[2][c] = c2[c] + distance;
+                paints[3][c] = c2[c] - distance;
+            }
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    const int32_t* paint = paints[pixelIndex(x, y)];
+                    setPixel(x, y, paint[0], paint[1], paint[2]);
+                }
+            }
+            return;
+        }
+
+        if (b2 < 0 || b2 > 31)
+        {
+            // Planar mode
+            const int32_t ro = Expand6((block[0] >> 1) & 0x3f);
+            const int32_t go = Expand7(((block[0] & 1) << 6) | ((block[1] >> 1) & 0x3f));
+            const int32_t bo = Expand6(((block[1] & 1) << 5) | (block[2] & 0x18) | ((block[2] << 1) & 6) | ((block[3] >> 7) & 1));
+            const int32_t rh = Expand6(((block[3] >> 1) & 0x3e) | (block[3] & 1));
+            const int32_t gh = Expand7((block[4] >> 1) & 0x7f);
+            const int32_t bh = Expand6(((block[4] & 1) << 5) | ((block[5] >> 3) & 0x1f));
+            const int32_t rv = Expand6(((block[5] & 7) << 3) | ((block[6] >> 5) & 7));
+            const int32_t gv = Expand7(((block[6] & 0x1f) << 2) | ((block[7] >> 6) & 3));
+            const int32_t bv = Expand6(block[7] & 0x3f);
+            for (int32_t y = 0; y < 4; ++y)
+            {
+                for (int32_t x = 0; x < 4; ++x)
+                {
+                    setPixel(x, y,
+                        (x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2,
+                        (x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2,
+                        (x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2);
+                }
+            }
+            return;
+        }
+
+        base[0][0] = Expand5(r); base[0][1] = Expand5(g); base[0][2] = Expand5(b);
+        base[1][0] = Expand5(r2); base[1][1] = Expand5(g2); base[1][2] = Expand5(b2);
+    }
+    else
+    {
+        base[0][0] = Expand4(block[0] >> 4); base[0][1] = Expand4(block[1] >> 4); base[0][2] = Expand4(block[2] >> 4);
+        base[1][0] = Expand4(block[0] & 0xf); base[1][1] = Expand4(block[1] & 0xf); base[1][2] = Expand4(block[2] & 0xf);
+    }
+
+    const uint32_t tables[2] = { uint32_t(block[3] >> 5), uint32_t((block[3] >> 2) & 7) };
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        for (uint32_t x = 0; x < 4; ++x)
+        {
+            const uint32_t subBlock = flip ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+            const uint32_t index = pixelIndex(x, y);
+            const int32_t modifier = (index & 2 ? -1 : 1) * ETC1Modifiers[tables[subBlock]][index & 1];
+            setPixel(x, y, base[subBlock][0] + modifier, base[subBlock][1] + modifier, base[subBlock][2] + modifier);
+        }
+    }
+}
+
+static void DecodeETC2RGB8Block(const uint8_t* block, uint8_t* pixels)
+{
+    DecodeETC2Colors(block, pixels);
+}
+
+static void DecodeETC2RGBA8Block(const uint8_t* block, uint8_t* pixels)
+{
+    DecodeETC2Colors(block + 8, pixels);
+
+    const int32_t base = block[0];
+    const int32_t multiplier = block[1] >> 4;
+    const int32_t* modifiers = EACModifiers[block[1] & 0xf];
+
+    uint64_t indices = 0;
+    for (int i = 2; i < 8; ++i)
+        indices = (indices << 8) | block[i];
+
+    for (uint32_t x = 0; x < 4; ++x)
+    {
+        for (uint32_t y = 0; y < 4; ++y)
+        {
+            const uint32_t index = uint32_t(indices >> (45 - 3 * (x * 4 + y))) & 7;
+            pixels[(y * 4 + x) * 4 + 3] = ClampColor(base + modifiers[index] * multiplier);
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// Uncompressed formats
+
+// The screenshot converter works on uint32_t rows, a long run of pixels is converted as several rows.
+static void ConvertPixels(ScreenshotDataFormat_t format, const void* data, size_t pixelCount, uint8_t* rgba)
+{
+    constexpr size_t MaxRowPixels = 0x10000000;
+    const size_t pixelSize = GetScreenshotFormatPixelSize(format);
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < pixelCount; i += MaxRowPixels)
+    {
+        const auto rowPixels = static_cast<uint32_t>(std::min(MaxRowPixels, pixelCount - i));
+        ConvertScreenshotData(format, src + i * pixelSize, rowPixels, 1, 0, ScreenshotOutputFormat_t::R8G8B8A8, rgba + i * 4, 0);
+    }
+}
+
+static void ConvertB8G8R8A8(const void* data, size_t pixelCount, uint8_t* rgba)
+{
+    SwapRedBlueChannels(data, pixelCount, rgba);
+}
+
+static void ConvertR5G6B5(const void* data, size_t pixelCount, uint8_t* rgba)
+{
+    ConvertPixels(ScreenshotDataFormat_t::R5G6B5, data, pixelCount, rgba);
+}
+
+static void ConvertA8(const void* data, size_t pixelCount, uint8_t* rgba)
+{
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+
+#if defined(INGAMEOVERLAY_FORMAT_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i white = _mm_set1_epi32(0x00ffffff);
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        const __m128i alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // Moves each alpha to the high byte of its pixel.
+        const __m128i low = _mm_unpacklo_epi8(zero, alpha);
+        const __m128i high = _mm_unpackhi_epi8(zero, alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4)     , _mm_or_si128(_mm_unpacklo_epi16(zero, low) , white));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4 + 16), _mm_or_si128(_mm_unpackhi_epi16(zero, low) , white));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4 + 32), _mm_or_si128(_mm_unpacklo_epi16(zero, high), white));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4 + 48), _mm_or_si128(_mm_unpackhi_epi16(zero, high), white));
+    }
+#endif
+
+    for (; i < pixelCount; ++i)
+    {
+        rgba[i * 4 + 0] = 255;
+        rgba[i * 4 + 1] = 255;
+        rgba[i * 4 + 2] = 255;
+        rgba[i * 4 + 3] = src[i];
+    }
+}
+
+static void ConvertR16G16B16A16Float(const void* data, size_t pixelCount, uint8_t* rgba)
+{
+    ConvertPixels(ScreenshotDataFormat_t::R16G16B16A16_FLOAT, data, pixelCount, rgba);
+}
+
+/////////////////////////////////////////////////////////////
+// Content hash, XXH64
+
+static constexpr uint64_t HashPrime1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t HashPrime2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t HashPrime3 = 0x165667B19E3779F9ull;
+static constexpr uint64_t HashPrime4 = 0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t HashPrime5 = 0x27D4EB2F165667C5ull;
+
+static inline uint64_t RotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t Read64(const uint8_t* data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static inline uint64_t HashRound(uint64_t accumulator, uint64_t input)
+{
+    return RotateLeft(accumulator + input * HashPrime2, 31) * HashPrime1;
+}
+
+static inline uint64_t HashMerge(uint64_t hash, uint64_t accumulator)
+{
+    return (hash ^ HashRound(0, accumulator)) * HashPrime1 + HashPrime4;
+}
+
+/////////////////////////////////////////////////////////////
+
+bool IsResourceFormatCompressed(ResourceFormat_t format)
+{
+    switch (format)
+    {
+        case ResourceFormat_t::BC1       :
+        case ResourceFormat_t::BC3       :
+        case ResourceFormat_t::BC7       :
+        case ResourceFormat_t::ETC2_RGB8 :
+        case ResourceFormat_t::ETC2_RGBA8: return true;
+        default                          : return false;
+    }
+}
+
+uint32_t GetResourceFormatElementSize(ResourceFormat_t format)
+{
+    switch (format)
+    {
+        case ResourceFormat_t::BC1       :
+        case ResourceFormat_t::ETC2_RGB8 : return 8;
+
+        case ResourceFormat_t::BC3       :
+        case ResourceFormat_t::BC7       :
+        case ResourceFormat_t::ETC2_RGBA8: return 16;
+
+        case ResourceFormat_t::A8                : return 1;
+        case ResourceFormat_t::R5G6B5            : return 2;
+        case ResourceFormat_t::R16G16B16A16_FLOAT: return 8;
+
+        case ResourceFormat_t::R8G8B8A8  :
+        case ResourceFormat_t::B8G8R8A8  :
+        default                          : return 4;
+    }
+}
+
+size_t GetResourceFormatRowPitch(ResourceFormat_t format, uint32_t width)
+{
+    return IsResourceFormatCompressed(format)
+        ? size_t((width + 3) / 4) * GetResourceFormatElementSize(format)
+        : size_t(width) * GetResourceFormatElementSize(format);
+}
+
+size_t GetResourceFormatDataSize(ResourceFormat_t format, uint32_t width, uint32_t height)
+{
+    return IsResourceFormatCompressed(format)
+        ? GetResourceFormatRowPitch(format, width) * ((height + 3) / 4)
+        : GetResourceFormatRowPitch(format, width) * height;
+}
+
+uint32_t GetMipLevelCount(uint32_t width, uint32_t height)
+{
+    uint32_t levels = 1;
+    for (auto size = std::max(width, height); size > 1; size /= 2)
+        ++levels;
+
+    return levels;
+}
+
+void SwapRedBlueChannels(const void* data, size_t pixelCount, uint8_t* output)
+{
+    ConvertPixels(ScreenshotDataFormat_t::B8G8R8A8, data, pixelCount, output);
+}
+
+bool ConvertResourceData(ResourceFormat_t format, const void* data, uint32_t width, uint32_t height, uint8_t* rgba)
+{
+    PixelConverter_t converter = nullptr;
+    switch (format)
+    {
+        case ResourceFormat_t::R8G8B8A8          : memcpy(rgba, data, size_t(width) * height * 4); return true;
+        case ResourceFormat_t::B8G8R8A8          : converter = ConvertB8G8R8A8         ; break;
+        case ResourceFormat_t::R5G6B5            : converter = ConvertR5G6B5           ; break;
+        case ResourceFormat_t::A8                : converter = ConvertA8               ; break;
+        case ResourceFormat_t::R16G16B16A16_FLOAT: converter = ConvertR16G16B16A16Float; break;
+        default: break;
+    }
+
+    if (converter != nullptr)
+    {
+        converter(data, size_t(width) * height, rgba);
+        return true;
+    }
+
+    BlockDecoder_t decoder;
+    switch (format)
+    {
+        case ResourceFormat_t::BC1       : decoder = DecodeBC1Block      ; break;
+        case ResourceFormat_t::BC3       : decoder = DecodeBC3Block      ; break;
+        case ResourceFormat_t::BC7       : decoder = DecodeBC7Block      ; break;
+        case ResourceFormat_t::ETC2_RGB8 : decoder = DecodeETC2RGB8Block ; break;
+        case ResourceFormat_t::ETC2_RGBA8: decoder = DecodeETC2RGBA8Block; break;
+        default: return false;
+    }
+
+    const uint32_t blockSize = GetResourceFormatElementSize(format);
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const uint8_t* block = reinterpret_cast<const uint8_t*>(data);
+    uint8_t pixels[16 * 4];
+
+    for (uint32_t by = 0; by < blocksY; ++by)
+    {
+        for (uint32_t bx = 0; bx < blocksX; ++bx, block += blockSize)
+        {
+            decoder(block, pixels);
+
+            // The blocks on the right and bottom edges can be partially outside of the image.
+            const uint32_t columns = std::min(4u, width - bx * 4);
+            const uint32_t rows = std::min(4u, height - by * 4);
+            for (uint32_t y = 0; y < rows; ++y)
+                memcpy(rgba + ((size_t(by) * 4 + y) * width + bx * 4) * 4, pixels + y * 16, columns * 4);
+        }
+    }
+
+    return true;
+}
+
+uint64_t HashResourceData(const void* data, size_t size)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    auto end = bytes + size;
+    uint64_t hash;
+
+    if (size >= 32)
+    {
+        // 4 independent lanes, the compiler keeps them in flight together.
+        uint64_t v1 = HashPrime1 + HashPrime2;
+        uint64_t v2 = HashPrime2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - HashPrime1;
+        for (; end - bytes >= 32; bytes += 32)
+        {
+            v1 = HashRound(v1, Read64(bytes));
+            v2 = HashRound(v2, Read64(bytes + 8));
+            v3 = HashRound(v3, Read64(bytes + 16));
+            v4 = HashRound(v4, Read64(bytes + 24));
+        }
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = HashMerge(hash, v1);
+        hash = HashMerge(hash, v2);
+        hash = HashMerge(hash, v3);
+        hash = HashMerge(hash, v4);
+    }
+    else
+    {
+        hash = HashPrime5;
+    }
+
+    hash += size;
+
+    for (; end - bytes >= 8; bytes += 8)
+        hash = RotateLeft(hash ^ HashRound(0, Read64(bytes)), 27) * HashPrime1 + HashPrime4;
+
+    if (end - bytes >= 4)
+    {
+        uint32_t value;
+        memcpy(&value, bytes, sizeof(value));
+        hash = RotateLeft(hash ^ (value * HashPrime1), 23) * HashPrime2 + HashPrime3;
+        bytes += 4;
+    }
+
+    for (; bytes < end; ++bytes)
+        hash = RotateLeft(hash ^ (*bytes * HashPrime5), 11) * HashPrime1;
+
+    hash ^= hash >> 33;
+    hash *= HashPrime2;
+    hash ^= hash >> 29;
+    hash *= HashPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <InGameOverlay/RendererResource.h>
+
+namespace InGameOverlay {
+
+bool IsResourceFormatCompressed(ResourceFormat_t format);
+
+// Bytes of a 4x4 block for the compressed formats, of a pixel for the others.
+uint32_t GetResourceFormatElementSize(ResourceFormat_t format);
+
+// Bytes of a row of pixels, or of a row of blocks for the compressed formats.
+size_t GetResourceFormatRowPitch(ResourceFormat_t format, uint32_t width);
+
+size_t GetResourceFormatDataSize(ResourceFormat_t format, uint32_t width, uint32_t height);
+
+// Levels of a full mip chain, down to 1x1.
+uint32_t GetMipLevelCount(uint32_t width, uint32_t height);
+
+// Swaps the first and third bytes of each 4 bytes pixel, RGBA to BGRA and back. data and output can be the same buffer.
+void SwapRedBlueChannels(const void* data, size_t pixelCount, uint8_t* output);
+
+// Converts or decompresses an image to RGBA, rgba must hold width * height * 4 bytes.
+bool ConvertResourceData(ResourceFormat_t format, const void* data, uint32_t width, uint32_t height, uint8_t* rgba);
+
+// 64 bits XXH64 hash of the data, used to find the resources with the same content.
+uint64_t HashResourceData(const void* data, size_t size);
+
+}
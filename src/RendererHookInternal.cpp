@@ -1,111 +1,922 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#include "RendererHookInternal.h"
-#include "RendererResourceInternal.h"
-
-namespace InGameOverlay {
-
-RendererHookInternal_t::RendererHookInternal_t() :
-    _ScreenshotCallback(nullptr),
-    _ScreenshotCallbackUserParameter(nullptr),
-    _TakeScreenshotType(ScreenshotType_t::None),
-    _BatchSize(10),
-    _CurrentFrame(0)
-{
-}
-
-RendererHookInternal_t::~RendererHookInternal_t()
-{
-}
-
-ScreenshotType_t RendererHookInternal_t::_ScreenshotType()
-{
-    return _TakeScreenshotType;
-}
-
-void RendererHookInternal_t::_SendScreenshot(ScreenshotCallbackParameter_t* screenshot)
-{
-    _TakeScreenshotType = ScreenshotType_t::None;
-    if (screenshot != nullptr && _ScreenshotCallback != nullptr)
-    {
-        switch (screenshot->Format)
-        {
-            case InGameOverlay::ScreenshotDataFormat_t::R5G6B5             : 
-            case InGameOverlay::ScreenshotDataFormat_t::X1R5G5B5           : 
-            case InGameOverlay::ScreenshotDataFormat_t::A1R5G5B5           : 
-            case InGameOverlay::ScreenshotDataFormat_t::B5G6R5             : 
-            case InGameOverlay::ScreenshotDataFormat_t::B5G5R5A1           : screenshot->PixelSize = 2 ; break;
-
-            case InGameOverlay::ScreenshotDataFormat_t::R8G8B8             : screenshot->PixelSize = 3 ; break;
-
-            case InGameOverlay::ScreenshotDataFormat_t::X8R8G8B8           : 
-            case InGameOverlay::ScreenshotDataFormat_t::A8R8G8B8           : 
-            case InGameOverlay::ScreenshotDataFormat_t::B8G8R8A8           : 
-            case InGameOverlay::ScreenshotDataFormat_t::B8G8R8X8           : 
-            case InGameOverlay::ScreenshotDataFormat_t::R8G8B8A8           : 
-            case InGameOverlay::ScreenshotDataFormat_t::A2R10G10B10        : 
-            case InGameOverlay::ScreenshotDataFormat_t::A2B10G10R10        : 
-            case InGameOverlay::ScreenshotDataFormat_t::R10G10B10A2        : screenshot->PixelSize = 4 ; break;
-
-            case InGameOverlay::ScreenshotDataFormat_t::R16G16B16A16_FLOAT : 
-            case InGameOverlay::ScreenshotDataFormat_t::R16G16B16A16_UNORM : screenshot->PixelSize = 8 ; break;
-
-            case InGameOverlay::ScreenshotDataFormat_t::R32G32B32A32_FLOAT : screenshot->PixelSize = 16; break;
-        }
-        _ScreenshotCallback(screenshot, _ScreenshotCallbackUserParameter);
-    }
-}
-
-void RendererHookInternal_t::SetScreenshotCallback(ScreenshotCallback_t callback, void* userParam)
-{
-    _ScreenshotCallback = callback;
-    _ScreenshotCallbackUserParameter = userParam;
-}
-
-uint32_t RendererHookInternal_t::GetAutoLoadBatchSize()
-{
-    return _BatchSize;
-}
-
-void RendererHookInternal_t::SetAutoLoadBatchSize(uint32_t batchSize)
-{
-    _BatchSize = batchSize;
-}
-
-void RendererHookInternal_t::TakeScreenshot(ScreenshotType_t type)
-{
-    _TakeScreenshotType = type;
-}
-
-RendererResource_t* RendererHookInternal_t::CreateResource()
-{
-    return new RendererResourceInternal_t(this);
-}
-
-RendererResource_t* RendererHookInternal_t::CreateAndAttachResource(const void* image_data, uint32_t width, uint32_t height)
-{
-    auto pResource = CreateResource();
-    if (pResource != nullptr)
-        pResource->AttachResource(image_data, width, height);
-
-    return pResource;
-}
-
-}
\ No newline at end of file
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "RendererHookInternal.h"
+#include "RendererResourceInternal.h"
+#include "RendererAtlasInternal.h"
+#include "RendererDecoderInternal.h"
+#include "RendererFormatInternal.h"
+
+#include <InGameOverlay/ScreenshotConverter.h>
+
+namespace InGameOverlay {
+
+static constexpr size_t RetiredTextureBatchSize = 64;
+static constexpr uint32_t DefaultScreenshotRingDepth = 3;
+static constexpr uint32_t MaxCaptureRingDepth = 8;
+
+RendererHookInternal_t::RendererHookInternal_t() :
+    _ScreenshotCallback(nullptr),
+    _ScreenshotCallbackUserParameter(nullptr),
+    _TakeScreenshotType(ScreenshotType_t::None),
+    _TakeScreenshotX(0),
+    _TakeScreenshotY(0),
+    _TakeScreenshotWidth(0),
+    _TakeScreenshotHeight(0),
+    _TakeScreenshotTargetWidth(0),
+    _TakeScreenshotTargetHeight(0),
+    _CaptureType(ScreenshotType_t::None),
+    _CaptureCallback(nullptr),
+    _CaptureCallbackUserParameter(nullptr),
+    _CaptureRingDepth(DefaultScreenshotRingDepth),
+    _CaptureInterval(0),
+    _CaptureRequested(false),
+    _NextScreenshotId(0),
+    _ScreenshotFrame(0),
+    _ResourceCommands(1024),
+    _ResourceCommandsOverflowing(false),
+    _ProcessingResourceCommands(false),
+    _CompletedFrame(0),
+    _TextureMemoryBudget(0),
+    _ResidentBytes(0),
+    _EvictionCount(0),
+    _EvictedBytes(0),
+    _ResourceDeduplication(false),
+    _BatchSize(10),
+    _LoadByteBudget(16 * 1024 * 1024),
+    _LoadTimeBudget(2000),
+    // Start pessimistic (1GiB/s), the first batches will correct it.
+    _LoadNanosecondsPerByte(1.0),
+    _UploadBufferSize(16 * 1024 * 1024),
+    _CurrentFrame(0)
+{
+}
+
+RendererHookInternal_t::~RendererHookInternal_t()
+{
+}
+
+ScreenshotType_t RendererHookInternal_t::_ScreenshotType()
+{
+    // The renderers call it before incrementing the frame counter, both the BeforeOverlay and AfterOverlay readbacks belong to the next frame.
+    _ScreenshotFrame = _CurrentFrame + 1;
+    _CaptureRequested = false;
+    if (_TakeScreenshotType != ScreenshotType_t::None || _CaptureType == ScreenshotType_t::None)
+        return _TakeScreenshotType;
+
+    // Every slot of the ring is in flight, the frame is dropped.
+    if (_PendingScreenshots.size() >= _CaptureRingDepth)
+        return ScreenshotType_t::None;
+
+    if (std::chrono::steady_clock::now() < _NextCaptureTime)
+        return ScreenshotType_t::None;
+
+    _CaptureRequested = true;
+    return _CaptureType;
+}
+
+RendererScreenshotRegion_t RendererHookInternal_t::_ScreenshotRegion(uint32_t sourceWidth, uint32_t sourceHeight) const
+{
+    RendererScreenshotRegion_t region{ 0, 0, sourceWidth, sourceHeight, sourceWidth, sourceHeight };
+    if (_CaptureRequested || sourceWidth == 0 || sourceHeight == 0)
+        return region;
+
+    if (_TakeScreenshotWidth != 0 && _TakeScreenshotHeight != 0)
+    {
+        region.X = std::min(_TakeScreenshotX, sourceWidth);
+        region.Y = std::min(_TakeScreenshotY, sourceHeight);
+        region.Width = std::min(_TakeScreenshotWidth, sourceWidth - region.X);
+        region.Height = std::min(_TakeScreenshotHeight, sourceHeight - region.Y);
+        region.TargetWidth = region.Width;
+        region.TargetHeight = region.Height;
+        if (region.Width == 0 || region.Height == 0)
+            return region;
+    }
+
+    if (_TakeScreenshotTargetWidth == 0 && _TakeScreenshotTargetHeight == 0)
+        return region;
+
+    // A missing dimension keeps the aspect ratio, the screenshot is never scaled up.
+    uint64_t targetWidth = _TakeScreenshotTargetWidth;
+    uint64_t targetHeight = _TakeScreenshotTargetHeight;
+    if (targetWidth == 0)
+        targetWidth = (targetHeight * region.Width + region.Height / 2) / region.Height;
+    else if (targetHeight == 0)
+        targetHeight = (targetWidth * region.Height + region.Width / 2) / region.Width;
+
+    region.TargetWidth = static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(targetWidth, 1), region.Width));
+    region.TargetHeight = static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(targetHeight, 1), region.Height));
+    return region;
+}
+
+uint32_t RendererHookInternal_t::_ScreenshotRingDepth() const
+{
+    return _CaptureType == ScreenshotType_t::None ? DefaultScreenshotRingDepth : std::max(DefaultScreenshotRingDepth, _CaptureRingDepth);
+}
+
+void RendererHookInternal_t::_SendScreenshot(ScreenshotCallbackParameter_t* screenshot)
+{
+    _SendScreenshot(screenshot, _BeginScreenshot());
+}
+
+uint64_t RendererHookInternal_t::_BeginScreenshot()
+{
+    const uint64_t screenshotId = _NextScreenshotId++;
+
+    if (_CaptureRequested)
+    {
+        // Keeps the rate without catching up on the frames that were dropped.
+        const auto now = std::chrono::steady_clock::now();
+        _NextCaptureTime += _CaptureInterval;
+        if (_NextCaptureTime < now)
+            _NextCaptureTime = now;
+
+        _CaptureRequested = false;
+        _PendingScreenshots.push_back({ screenshotId, _ScreenshotFrame, true });
+    }
+    else
+    {
+        _TakeScreenshotType = ScreenshotType_t::None;
+        _PendingScreenshots.push_back({ screenshotId, _ScreenshotFrame, false });
+    }
+
+    return screenshotId;
+}
+
+void RendererHookInternal_t::_SendScreenshot(ScreenshotCallbackParameter_t* screenshot, uint64_t screenshotId)
+{
+    auto it = std::find_if(_PendingScreenshots.begin(), _PendingScreenshots.end(), [screenshotId](RendererPendingScreenshot_t const& pending)
+    {
+        return pending.Id == screenshotId;
+    });
+
+    if (it == _PendingScreenshots.end())
+        return;
+
+    const bool capture = it->Capture;
+    const uint64_t frameIndex = it->Frame;
+    _PendingScreenshots.erase(it);
+
+    auto callback = capture ? _CaptureCallback : _ScreenshotCallback;
+    auto userParameter = capture ? _CaptureCallbackUserParameter : _ScreenshotCallbackUserParameter;
+
+    if (screenshot != nullptr && callback != nullptr)
+    {
+        screenshot->FrameIndex = frameIndex;
+        screenshot->PixelSize = GetScreenshotFormatPixelSize(screenshot->Format);
+        callback(screenshot, userParameter);
+    }
+}
+
+void RendererHookInternal_t::SetScreenshotCallback(ScreenshotCallback_t callback, void* userParam)
+{
+    _ScreenshotCallback = callback;
+    _ScreenshotCallbackUserParameter = userParam;
+}
+
+uint32_t RendererHookInternal_t::GetAutoLoadBatchSize()
+{
+    return _BatchSize;
+}
+
+void RendererHookInternal_t::SetAutoLoadBatchSize(uint32_t batchSize)
+{
+    _BatchSize = batchSize;
+}
+
+uint32_t RendererHookInternal_t::GetAutoLoadByteBudget()
+{
+    return _LoadByteBudget;
+}
+
+void RendererHookInternal_t::SetAutoLoadByteBudget(uint32_t bytesPerFrame)
+{
+    _LoadByteBudget = bytesPerFrame;
+}
+
+uint32_t RendererHookInternal_t::GetAutoLoadTimeBudget()
+{
+    return _LoadTimeBudget;
+}
+
+void RendererHookInternal_t::SetAutoLoadTimeBudget(uint32_t microsecondsPerFrame)
+{
+    _LoadTimeBudget = microsecondsPerFrame;
+}
+
+size_t RendererHookInternal_t::_BeginLoadBatch(std::vector<RendererTextureLoadParameter_t> const& loadParameters)
+{
+    const double timeBudget = _LoadTimeBudget * 1000.0;
+    uint64_t batchBytes = 0;
+    size_t count = 0;
+
+    _LoadBatchStart = std::chrono::steady_clock::now();
+
+    for (auto const& param : loadParameters)
+    {
+        if (_BatchSize != 0 && count >= _BatchSize)
+            break;
+
+        // Released resources are skipped by the renderer, they cost nothing.
+        if (GetTextureSlot(param.Resource) != nullptr)
+        {
+            const uint64_t bytes = GetResourceFormatDataSize(param.Format, param.Width, param.Height);
+            if (count != 0)
+            {
+                if (_LoadByteBudget != 0 && batchBytes + bytes > _LoadByteBudget)
+                    break;
+
+                if (_LoadTimeBudget != 0 && (batchBytes + bytes) * _LoadNanosecondsPerByte > timeBudget)
+                    break;
+            }
+            batchBytes += bytes;
+        }
+        ++count;
+    }
+
+    return count;
+}
+
+void RendererHookInternal_t::_EndLoadBatch(uint64_t loadedBytes)
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _LoadBatchStart).count();
+
+    // Too small batches are dominated by the per texture overhead and would make the big images look expensive.
+    if (loadedBytes < 64 * 1024 || elapsed <= 0)
+        return;
+
+    _LoadNanosecondsPerByte = _LoadNanosecondsPerByte * 0.75 + (double(elapsed) / loadedBytes) * 0.25;
+}
+
+RendererTextureHandle_t RendererHookInternal_t::_InsertTexture(std::shared_ptr<RendererTexture_t> texture)
+{
+    uint32_t index;
+    if (_FreeTextureSlots.empty())
+    {
+        index = static_cast<uint32_t>(_TextureSlots.size());
+        _TextureSlots.emplace_back();
+        _Textures.emplace_back();
+    }
+    else
+    {
+        index = _FreeTextureSlots.back();
+        _FreeTextureSlots.pop_back();
+    }
+
+    auto& slot = _TextureSlots[index];
+    ++slot.Generation;
+    slot.ImGuiTextureId = 0;
+    slot.LoadStatus = RendererTextureStatus_e::NotLoaded;
+
+    texture->Handle = RendererTextureHandle_t{ index, slot.Generation };
+    _Textures[index] = std::move(texture);
+    return _Textures[index]->Handle;
+}
+
+std::shared_ptr<RendererTexture_t> RendererHookInternal_t::_RemoveTexture(RendererTextureHandle_t handle)
+{
+    auto slot = GetTextureSlot(handle);
+    if (slot == nullptr)
+        return nullptr;
+
+    ++slot->Generation;
+    slot->ImGuiTextureId = 0;
+    slot->LoadStatus = RendererTextureStatus_e::NotLoaded;
+    _FreeTextureSlots.emplace_back(handle.Index);
+    return std::move(_Textures[handle.Index]);
+}
+
+std::shared_ptr<RendererTexture_t> RendererHookInternal_t::_GetTexture(RendererTextureHandle_t handle)
+{
+    return GetTextureSlot(handle) == nullptr ? nullptr : _Textures[handle.Index];
+}
+
+void RendererHookInternal_t::_SetTextureLoadStatus(RendererTextureHandle_t handle, RendererTextureStatus_e status)
+{
+    auto slot = GetTextureSlot(handle);
+    if (slot == nullptr)
+        return;
+
+    slot->LoadStatus = status;
+    if (status == RendererTextureStatus_e::Loaded)
+        slot->ImGuiTextureId = _Textures[handle.Index]->ImGuiTextureId;
+}
+
+size_t RendererHookInternal_t::_LoadedTextureCount() const
+{
+    return std::count_if(_TextureSlots.begin(), _TextureSlots.end(), [](RendererTextureSlot_t const& slot) { return slot.LoadStatus == RendererTextureStatus_e::Loaded; });
+}
+
+void RendererHookInternal_t::_ClearTextures()
+{
+    _FreeTextureSlots.clear();
+    for (uint32_t i = 0; i < _TextureSlots.size(); ++i)
+    {
+        auto& slot = _TextureSlots[i];
+        // Keep the generations, the resources still hold handles on these slots.
+        if ((slot.Generation & 1) != 0)
+            ++slot.Generation;
+
+        slot.ImGuiTextureId = 0;
+        slot.LoadStatus = RendererTextureStatus_e::NotLoaded;
+        _Textures[i].reset();
+        _FreeTextureSlots.emplace_back(i);
+    }
+}
+
+void RendererHookInternal_t::_RetireTexture(std::shared_ptr<RendererTexture_t> texture)
+{
+    // A texture released while the overlay is drawn can already be in the frame draw list.
+    _RetiredTextures.emplace_back(RendererTextureReleaseParameter_t
+    {
+        std::move(texture),
+        _CurrentFrame
+    });
+}
+
+void RendererHookInternal_t::_SetCompletedFrame(uint64_t frame)
+{
+    _CompletedFrame = std::max(_CompletedFrame, frame);
+}
+
+void RendererHookInternal_t::_ReleaseRetiredTextures()
+{
+    for (size_t i = 0; i < RetiredTextureBatchSize && !_RetiredTextures.empty() && _RetiredTextures.front().RetireFrame <= _CompletedFrame; ++i)
+        _RetiredTextures.pop_front();
+}
+
+void RendererHookInternal_t::_ClearRetiredTextures()
+{
+    _RetiredTextures.clear();
+}
+
+size_t RendererHookInternal_t::_RetiredTextureCount() const
+{
+    return _RetiredTextures.size();
+}
+
+uint32_t RendererHookInternal_t::GetUploadBufferSize()
+{
+    return _UploadBufferSize;
+}
+
+void RendererHookInternal_t::SetUploadBufferSize(uint32_t size)
+{
+    _UploadBufferSize = size;
+}
+
+bool RendererHookInternal_t::GetTextureMemoryStats(RendererTextureMemoryStats_t* /*stats*/)
+{
+    return false;
+}
+
+uint64_t RendererHookInternal_t::GetTextureMemoryBudget()
+{
+    return _TextureMemoryBudget;
+}
+
+void RendererHookInternal_t::SetTextureMemoryBudget(uint64_t bytes)
+{
+    // Applied on the next load, the resources can only be unloaded from the render thread.
+    _TextureMemoryBudget = bytes;
+}
+
+void RendererHookInternal_t::GetResidencyStats(RendererResidencyStats_t* stats)
+{
+    if (stats == nullptr)
+        return;
+
+    stats->ResidentBytes = _ResidentBytes;
+    stats->BudgetBytes = _TextureMemoryBudget;
+    stats->ResidentCount = _ResidentResources.size();
+    stats->EvictionCount = _EvictionCount;
+    stats->EvictedBytes = _EvictedBytes;
+}
+
+bool RendererHookInternal_t::GetResourceDeduplication()
+{
+    return _ResourceDeduplication;
+}
+
+void RendererHookInternal_t::SetResourceDeduplication(bool enable)
+{
+    _ResourceDeduplication = enable;
+}
+
+void RendererHookInternal_t::TakeScreenshot(ScreenshotType_t type)
+{
+    TakeScreenshot(type, 0, 0);
+}
+
+void RendererHookInternal_t::TakeScreenshot(ScreenshotType_t type, uint32_t width, uint32_t height)
+{
+    _TakeScreenshotX = 0;
+    _TakeScreenshotY = 0;
+    _TakeScreenshotWidth = 0;
+    _TakeScreenshotHeight = 0;
+    _TakeScreenshotTargetWidth = width;
+    _TakeScreenshotTargetHeight = height;
+    _TakeScreenshotType = type;
+}
+
+void RendererHookInternal_t::TakeScreenshot(ScreenshotType_t type, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    _TakeScreenshotX = x;
+    _TakeScreenshotY = y;
+    _TakeScreenshotWidth = width;
+    _TakeScreenshotHeight = height;
+    _TakeScreenshotTargetWidth = 0;
+    _TakeScreenshotTargetHeight = 0;
+    _TakeScreenshotType = type;
+}
+
+bool RendererHookInternal_t::StartCapture(uint32_t fps, ScreenshotCallback_t callback, void* userParameter, uint32_t ringDepth, ScreenshotType_t type)
+{
+    if (callback == nullptr || type == ScreenshotType_t::None)
+        return false;
+
+    _CaptureCallback = callback;
+    _CaptureCallbackUserParameter = userParameter;
+    _CaptureRingDepth = std::min(std::max(ringDepth, 1u), MaxCaptureRingDepth);
+    _CaptureInterval = fps == 0
+        ? std::chrono::steady_clock::duration(0)
+        : std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(1000000000ull / fps));
+    _NextCaptureTime = std::chrono::steady_clock::now();
+    _CaptureType = type;
+    return true;
+}
+
+void RendererHookInternal_t::StopCapture()
+{
+    _CaptureType = ScreenshotType_t::None;
+    _CaptureCallback = nullptr;
+    _CaptureCallbackUserParameter = nullptr;
+}
+
+bool RendererHookInternal_t::IsCapturing() const
+{
+    return _CaptureType != ScreenshotType_t::None;
+}
+
+bool RendererHookInternal_t::IsRenderThread() const
+{
+    return _RenderThreadId.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
+void RendererHookInternal_t::PostResourceCommand(RendererResourceCommand_t const& command)
+{
+    if (!_ResourceCommandsOverflowing.load(std::memory_order_acquire) && _ResourceCommands.enqueue(command))
+        return;
+
+    std::lock_guard<std::mutex> lock(_ResourceCommandsOverflowMutex);
+    _ResourceCommandsOverflow.emplace_back(command);
+    _ResourceCommandsOverflowing.store(true, std::memory_order_release);
+}
+
+void RendererHookInternal_t::PostResourceCommands(RendererResourceCommand_t const* commands, size_t count)
+{
+    size_t i = 0;
+    // Nothing drains the queue before the first frame, it would only fill up.
+    if (_RenderThreadId.load(std::memory_order_relaxed) != std::thread::id())
+    {
+        while (i < count && !_ResourceCommandsOverflowing.load(std::memory_order_acquire) && _ResourceCommands.enqueue(commands[i]))
+            ++i;
+    }
+
+    if (i == count)
+        return;
+
+    std::lock_guard<std::mutex> lock(_ResourceCommandsOverflowMutex);
+    _ResourceCommandsOverflow.insert(_ResourceCommandsOverflow.end(), commands + i, commands + count);
+    _ResourceCommandsOverflowing.store(true, std::memory_order_release);
+}
+
+bool RendererHookInternal_t::HasPendingResourceCommands() const
+{
+    return !_ProcessingResourceCommands && (_ResourceCommands.queue_size() != 0 || _ResourceCommandsOverflowing.load(std::memory_order_acquire));
+}
+
+void RendererHookInternal_t::_RunResourceCommand(RendererResourceCommand_t const& command)
+{
+    switch (command.Type)
+    {
+        case RendererResourceCommandType_e::Attach:
+            command.Resource->AttachResource(command.Data, command.Width, command.Height);
+            break;
+
+        case RendererResourceCommandType_e::AttachFormatted:
+            command.Resource->AttachResource(command.Data, command.Width, command.Height, command.Format);
+            break;
+
+        case RendererResourceCommandType_e::AttachOwned:
+            command.Resource->AttachResource(const_cast<void*>(command.Data), command.Width, command.Height, command.ReleaseCallback, command.UserParameter, command.Flag);
+            break;
+
+        case RendererResourceCommandType_e::Unload:
+            command.Resource->Unload(command.Flag);
+            break;
+
+        case RendererResourceCommandType_e::Delete:
+            command.Resource->Delete();
+            break;
+
+        case RendererResourceCommandType_e::Preload:
+            _PreloadInsert(static_cast<RendererResourceInternal_t*>(command.Resource), command.Priority);
+            break;
+    }
+}
+
+void RendererHookInternal_t::_ProcessResourceCommands()
+{
+    _RenderThreadId.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+    _ProcessingResourceCommands = true;
+
+    // The commands posted while draining are replayed next frame.
+    RendererResourceCommand_t command;
+    size_t commandCount = _ResourceCommands.queue_size();
+    while (commandCount-- && _ResourceCommands.dequeue(command))
+        _RunResourceCommand(command);
+
+    if (_ResourceCommandsOverflowing.load(std::memory_order_acquire))
+    {
+        std::vector<RendererResourceCommand_t> commands;
+        {
+            std::lock_guard<std::mutex> lock(_ResourceCommandsOverflowMutex);
+            // The commands still in the queue were posted before the overflowed ones.
+            while (_ResourceCommands.dequeue(command))
+                commands.emplace_back(command);
+
+            commands.insert(commands.end(), _ResourceCommandsOverflow.begin(), _ResourceCommandsOverflow.end());
+            _ResourceCommandsOverflow.clear();
+            _ResourceCommandsOverflowing.store(false, std::memory_order_release);
+        }
+
+        for (auto const& overflowCommand : commands)
+            _RunResourceCommand(overflowCommand);
+    }
+    _ProcessingResourceCommands = false;
+}
+
+void RendererHookInternal_t::_PreloadInsert(RendererResourceInternal_t* resource, int32_t priority)
+{
+    if (resource->_Preloading)
+        PreloadRemove(resource);
+
+    // After the resources of the same priority, they are loaded in the order they were given.
+    auto it = std::upper_bound(_Preloads.begin(), _Preloads.end(), priority, [](int32_t priority, RendererPreload_t const& preload)
+    {
+        return priority > preload.Priority;
+    });
+
+    _Preloads.insert(it, RendererPreload_t{ resource, priority });
+    resource->_Preloading = true;
+}
+
+void RendererHookInternal_t::_ProcessPreloads()
+{
+    if (_Preloads.empty())
+        return;
+
+    // Keep at most a batch of preloads in flight, the resources drawn this frame were queued first.
+    const uint32_t maxPending = _BatchSize == 0 ? 10 : _BatchSize;
+    uint32_t pending = 0;
+
+    size_t kept = 0;
+    size_t i = 0;
+    for (; i < _Preloads.size() && pending < maxPending; ++i)
+    {
+        auto& preload = _Preloads[i];
+        // Starts the load like a draw would, a decoded resource waits for its decoder.
+        if (preload.Resource->GetResourceId() != 0 || !preload.Resource->HasAttachedResource())
+        {
+            preload.Resource->_Preloading = false;
+            continue;
+        }
+
+        ++pending;
+        _Preloads[kept++] = preload;
+    }
+    _Preloads.erase(_Preloads.begin() + kept, _Preloads.begin() + i);
+}
+
+void RendererHookInternal_t::Preload(RendererResource_t* const* resources, size_t count, int32_t priority)
+{
+    if (IsRenderThread())
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (resources[i] != nullptr)
+                _PreloadInsert(static_cast<RendererResourceInternal_t*>(resources[i]), priority);
+        }
+        return;
+    }
+
+    std::vector<RendererResourceCommand_t> commands;
+    commands.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (resources[i] == nullptr)
+            continue;
+
+        RendererResourceCommand_t command;
+        command.Type = RendererResourceCommandType_e::Preload;
+        command.Resource = resources[i];
+        command.Priority = priority;
+        commands.emplace_back(command);
+    }
+
+    PostResourceCommands(commands.data(), commands.size());
+}
+
+void RendererHookInternal_t::PreloadRemove(RendererResourceInternal_t* resource)
+{
+    auto it = std::find_if(_Preloads.begin(), _Preloads.end(), [resource](RendererPreload_t const& preload)
+    {
+        return preload.Resource == resource;
+    });
+
+    if (it != _Preloads.end())
+        _Preloads.erase(it);
+
+    resource->_Preloading = false;
+}
+
+RendererResource_t* RendererHookInternal_t::CreateResource()
+{
+    return new RendererResourceInternal_t(this);
+}
+
+RendererResource_t* RendererHookInternal_t::CreateAndAttachResource(const void* image_data, uint32_t width, uint32_t height)
+{
+    auto pResource = CreateResource();
+    if (pResource != nullptr)
+        pResource->AttachResource(image_data, width, height);
+
+    return pResource;
+}
+
+RendererResource_t* RendererHookInternal_t::CreateAtlasedResource()
+{
+    return new RendererAtlasedResourceInternal_t(this);
+}
+
+RendererResource_t* RendererHookInternal_t::CreateResourceFromEncoded(const void* data, size_t size)
+{
+    auto decodeJob = std::make_shared<RendererDecodeJob_t>();
+    if (data != nullptr && size != 0)
+    {
+        decodeJob->EncodedData.assign(reinterpret_cast<const uint8_t*>(data), reinterpret_cast<const uint8_t*>(data) + size);
+
+        if (_DecoderPool == nullptr)
+            _DecoderPool.reset(new RendererDecoderPool_t);
+
+        _DecoderPool->Push(decodeJob);
+    }
+    else
+    {
+        decodeJob->Status = RendererDecodeStatus_e::Failed;
+    }
+
+    return new RendererDecodedResourceInternal_t(this, std::move(decodeJob));
+}
+
+bool RendererHookInternal_t::IsResourceFormatSupported(ResourceFormat_t format, uint32_t /*width*/, uint32_t /*height*/)
+{
+    return format == ResourceFormat_t::R8G8B8A8;
+}
+
+bool RendererHookInternal_t::UpdateImageResource(RendererTextureUpdateParameter_t& /*updateParameter*/)
+{
+    return false;
+}
+
+RendererAtlasPage_t* RendererHookInternal_t::AtlasInsert(RendererAtlasedResourceInternal_t* resource, uint32_t width, uint32_t height, RendererAtlasRect_t& rect)
+{
+    RendererAtlasPage_t* page = nullptr;
+
+    // Fill the existing pages first, then try to reclaim the space of the removed images and only then grow the pages.
+    for (auto& p : _AtlasPages)
+    {
+        if (p->Insert(width, height, rect))
+        {
+            page = p.get();
+            break;
+        }
+    }
+
+    for (auto it = _AtlasPages.begin(); page == nullptr && it != _AtlasPages.end(); ++it)
+    {
+        if ((*it)->ShouldRepack() && (*it)->Repack() && (*it)->Insert(width, height, rect))
+            page = it->get();
+    }
+
+    for (auto it = _AtlasPages.begin(); page == nullptr && it != _AtlasPages.end(); ++it)
+    {
+        while ((*it)->Grow())
+        {
+            if ((*it)->Insert(width, height, rect))
+            {
+                page = it->get();
+                break;
+            }
+        }
+    }
+
+    if (page == nullptr)
+    {
+        _AtlasPages.emplace_back(new RendererAtlasPage_t(this));
+        if (!_AtlasPages.back()->Insert(width, height, rect))
+        {
+            _AtlasPages.pop_back();
+            return nullptr;
+        }
+
+        page = _AtlasPages.back().get();
+    }
+
+    page->Entries.emplace_back(resource);
+    return page;
+}
+
+void RendererHookInternal_t::AtlasRemove(RendererAtlasPage_t* page, RendererAtlasedResourceInternal_t* resource)
+{
+    auto entryIt = std::find(page->Entries.begin(), page->Entries.end(), resource);
+    if (entryIt != page->Entries.end())
+        page->Entries.erase(entryIt);
+
+    page->Remove(resource->Rect());
+
+    if (page->IsEmpty())
+    {
+        page->Release(this);
+        _AtlasPages.erase(std::find_if(_AtlasPages.begin(), _AtlasPages.end(), [page](std::unique_ptr<RendererAtlasPage_t> const& p)
+        {
+            return p.get() == page;
+        }));
+    }
+}
+
+RendererTextureHandle_t RendererHookInternal_t::AcquireSharedImageResource(RendererTextureKey_t const& key)
+{
+    auto& sharedTexture = _SharedTextures[key];
+    if (GetTextureSlot(sharedTexture.Texture) == nullptr)
+    {
+        // New content, or the renderer released the texture (reset, device lost): the holders of the old one will release it on their own.
+        sharedTexture.Texture = AllocImageResource();
+        sharedTexture.References = 0;
+        if (sharedTexture.ResidentReferences != 0)
+            _ResidentBytes -= sharedTexture.Bytes;
+        sharedTexture.ResidentReferences = 0;
+        sharedTexture.Bytes = 0;
+    }
+
+    ++sharedTexture.References;
+    return sharedTexture.Texture;
+}
+
+void RendererHookInternal_t::ReleaseSharedImageResource(RendererTextureKey_t const& key, RendererTextureHandle_t resource)
+{
+    auto it = _SharedTextures.find(key);
+    if (it == _SharedTextures.end() || it->second.Texture != resource)
+    {
+        // Not the texture currently shared, it has no other holder.
+        ReleaseImageResource(resource);
+        return;
+    }
+
+    if (--it->second.References == 0)
+    {
+        ReleaseImageResource(it->second.Texture);
+        _SharedTextures.erase(it);
+    }
+}
+
+RendererSharedTexture_t* RendererHookInternal_t::_FindSharedTexture(RendererResourceInternal_t* resource)
+{
+    if (!resource->_RendererResource.Shared)
+        return nullptr;
+
+    auto it = _SharedTextures.find(resource->_RendererResource.SharedKey);
+    return it != _SharedTextures.end() && it->second.Texture == resource->_RendererResource.RendererResource
+        ? &it->second
+        : nullptr;
+}
+
+void RendererHookInternal_t::ResidencyInsert(RendererResourceInternal_t* resource, uint64_t bytes)
+{
+    ResidencyRemove(resource);
+
+    resource->_ResidencyIterator = _ResidentResources.insert(_ResidentResources.begin(), resource);
+    resource->_Resident = true;
+    resource->_ResidentBytes = bytes;
+    resource->_LastUsedFrame = _CurrentFrame;
+
+    auto sharedTexture = _FindSharedTexture(resource);
+    if (sharedTexture != nullptr)
+    {
+        if (bytes != 0)
+            sharedTexture->Bytes = bytes;
+
+        resource->_ResidentBytes = sharedTexture->Bytes;
+        if (sharedTexture->ResidentReferences++ == 0)
+            _ResidentBytes += sharedTexture->Bytes;
+    }
+    else
+    {
+        _ResidentBytes += bytes;
+    }
+
+    _EvictResidentResources();
+}
+
+void RendererHookInternal_t::ResidencyTouch(RendererResourceInternal_t* resource)
+{
+    if (!resource->_Resident)
+    {
+        // Drawing a shared texture loaded by another resource, it keeps the texture used while the loader is not.
+        if (resource->_RendererResource.Shared)
+            ResidencyInsert(resource, 0);
+
+        return;
+    }
+
+    resource->_LastUsedFrame = _CurrentFrame;
+    _ResidentResources.splice(_ResidentResources.begin(), _ResidentResources, resource->_ResidencyIterator);
+}
+
+void RendererHookInternal_t::ResidencyRemove(RendererResourceInternal_t* resource)
+{
+    if (!resource->_Resident)
+        return;
+
+    _ResidentResources.erase(resource->_ResidencyIterator);
+
+    if (resource->_RendererResource.Shared)
+    {
+        // Not found once the renderer released it, its bytes were removed when it was allocated again.
+        auto sharedTexture = _FindSharedTexture(resource);
+        if (sharedTexture != nullptr && --sharedTexture->ResidentReferences == 0)
+            _ResidentBytes -= sharedTexture->Bytes;
+    }
+    else
+    {
+        _ResidentBytes -= resource->_ResidentBytes;
+    }
+
+    resource->_Resident = false;
+    resource->_ResidentBytes = 0;
+}
+
+void RendererHookInternal_t::_EvictResidentResources()
+{
+    if (_TextureMemoryBudget == 0)
+        return;
+
+    auto it = _ResidentResources.end();
+    while (_ResidentBytes > _TextureMemoryBudget && it != _ResidentResources.begin())
+    {
+        auto resource = *--it;
+        // The list is sorted by use, everything before was used in this frame too.
+        if (resource->_LastUsedFrame >= _CurrentFrame)
+            break;
+
+        // Keep the iterator on the next resource, the evicted one is removed from the list.
+        ++it;
+        auto sharedTexture = _FindSharedTexture(resource);
+        if (GetTextureSlot(resource->_RendererResource.RendererResource) == nullptr)
+        {
+            // Released by the renderer (reset, device lost), nothing to evict.
+            ResidencyRemove(resource);
+        }
+        else if (resource->_Data != nullptr && (sharedTexture == nullptr || sharedTexture->References == 1))
+        {
+            ++_EvictionCount;
+            _EvictedBytes += resource->_ResidentBytes;
+            resource->Evict();
+        }
+        else
+        {
+            // Can't be loaded again, or other resources still draw its texture and evicting it would free nothing, keep it.
+            --it;
+        }
+    }
+}
+
+}
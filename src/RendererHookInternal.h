@@ -1,97 +1,456 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#pragma once
-
-#include <InGameOverlay/RendererHook.h>
-#include "InternalIncludes.h"
-
-#include <set>
-#include <memory>
-#include <algorithm>
-
-namespace InGameOverlay {
-
-enum class RendererTextureStatus_e
-{
-    NotLoaded,
-    Loading,
-    Loaded,
-};
-
-struct RendererTexture_t
-{
-    uint64_t ImGuiTextureId = 0;
-    RendererTextureStatus_e LoadStatus = RendererTextureStatus_e::NotLoaded;
-};
-
-struct RendererTextureLoadParameter_t
-{
-    std::weak_ptr<RendererTexture_t> Resource;
-    const void* Data;
-    uint32_t Height;
-    uint32_t Width;
-};
-
-struct RendererTextureReleaseParameter_t
-{
-    std::shared_ptr<RendererTexture_t> Resource;
-    uint64_t ReleaseFrame;
-};
-
-class RendererResourceInternal_t;
-
-class RendererHookInternal_t : public RendererHook_t
-{
-    ScreenshotCallback_t _ScreenshotCallback;
-    void* _ScreenshotCallbackUserParameter;
-    ScreenshotType_t _TakeScreenshotType;
-
-protected:
-    uint32_t _BatchSize;
-    uint64_t _CurrentFrame;
-
-    RendererHookInternal_t();
-    virtual ~RendererHookInternal_t();
-
-    ScreenshotType_t _ScreenshotType();
-
-    void _SendScreenshot(ScreenshotCallbackParameter_t* screenshot);
-
-public:
-    virtual void SetScreenshotCallback(ScreenshotCallback_t callback, void* userParam);
-
-    virtual uint32_t GetAutoLoadBatchSize();
-
-    virtual void SetAutoLoadBatchSize(uint32_t batchSize);
-
-    virtual RendererResource_t* CreateResource();
-
-    virtual RendererResource_t* CreateAndAttachResource(const void* image_data, uint32_t width, uint32_t height);
-
-    virtual void TakeScreenshot(ScreenshotType_t type);
-
-    virtual std::weak_ptr<RendererTexture_t> AllocImageResource() = 0;
-
-    virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter) = 0;
-
-    virtual void ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource) = 0;
-};
-
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <InGameOverlay/RendererHook.h>
+#include "InternalIncludes.h"
+#include "mpmc_bounded_queue.h"
+
+#include <set>
+#include <list>
+#include <deque>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace InGameOverlay {
+
+enum class RendererTextureStatus_e
+{
+    NotLoaded,
+    Loading,
+    Loaded,
+};
+
+// Index of a slot in the renderer texture table and the generation of the texture it refers to.
+// The slot generation changes when its texture is released, the handles kept on it are then ignored.
+struct RendererTextureHandle_t
+{
+    uint32_t Index = 0;
+    uint32_t Generation = 0;
+
+    inline bool IsValid() const
+    {
+        return Generation != 0;
+    }
+
+    inline bool operator==(RendererTextureHandle_t const& other) const
+    {
+        return Index == other.Index && Generation == other.Generation;
+    }
+
+    inline bool operator!=(RendererTextureHandle_t const& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// The renderer object of a texture, subclassed by the renderers that need more than the ImGui texture id to release it.
+struct RendererTexture_t
+{
+    RendererTextureHandle_t Handle;
+    uint64_t ImGuiTextureId = 0;
+    // Set by the renderer when it generated the mipmaps, updates have to generate them again.
+    uint32_t MipLevels = 1;
+};
+
+// What GetResourceId reads every frame, kept in a contiguous array apart from the renderer objects.
+struct RendererTextureSlot_t
+{
+    uint64_t ImGuiTextureId = 0;
+    RendererTextureStatus_e LoadStatus = RendererTextureStatus_e::NotLoaded;
+    // Odd while the slot holds a texture, even while it is free.
+    uint32_t Generation = 0;
+};
+
+// Identifies the textures shared by the resources with the same content.
+struct RendererTextureKey_t
+{
+    uint64_t Hash = 0;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    ResourceFormat_t Format = ResourceFormat_t::R8G8B8A8;
+    bool GenerateMipmaps = false;
+
+    inline bool operator==(RendererTextureKey_t const& other) const
+    {
+        return Hash == other.Hash && Width == other.Width && Height == other.Height && Format == other.Format && GenerateMipmaps == other.GenerateMipmaps;
+    }
+};
+
+struct RendererTextureKeyHash_t
+{
+    inline size_t operator()(RendererTextureKey_t const& key) const
+    {
+        return static_cast<size_t>(key.Hash ^ ((uint64_t(key.Width) << 32) | key.Height));
+    }
+};
+
+struct RendererSharedTexture_t
+{
+    RendererTextureHandle_t Texture;
+    uint32_t References = 0;
+    // The holders in the resident list, the texture bytes are counted once while there is one.
+    uint32_t ResidentReferences = 0;
+    uint64_t Bytes = 0;
+};
+
+struct RendererTextureLoadParameter_t
+{
+    RendererTextureHandle_t Resource;
+    const void* Data;
+    // Keeps the data alive until the load is done when the resource owns it.
+    std::shared_ptr<void> DataOwner;
+    uint32_t Height;
+    uint32_t Width;
+    // Only the formats the renderer supports are loaded, the others are converted to R8G8B8A8 first.
+    ResourceFormat_t Format = ResourceFormat_t::R8G8B8A8;
+    // Never set for block compressed data, the renderers that can't generate them ignore it.
+    bool GenerateMipmaps = false;
+};
+
+struct RendererTextureUpdateParameter_t
+{
+    RendererTextureHandle_t Resource;
+    // The RGBA pixels of the region, without padding between the rows.
+    std::vector<uint8_t> Data;
+    uint32_t X;
+    uint32_t Y;
+    uint32_t Width;
+    uint32_t Height;
+};
+
+struct RendererTextureReleaseParameter_t
+{
+    std::shared_ptr<RendererTexture_t> Resource;
+    // The last frame that could draw the texture, it is destroyed once the GPU completed it.
+    uint64_t RetireFrame;
+};
+
+enum class RendererResourceCommandType_e
+{
+    Attach,
+    AttachFormatted,
+    AttachOwned,
+    Unload,
+    Delete,
+    Preload,
+};
+
+// A resource call made outside of the render thread, replayed at the start of the next overlay frame.
+struct RendererResourceCommand_t
+{
+    RendererResourceCommandType_e Type = RendererResourceCommandType_e::Attach;
+    RendererResource_t* Resource = nullptr;
+    const void* Data = nullptr;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    ResourceFormat_t Format = ResourceFormat_t::R8G8B8A8;
+    ResourceDataReleaseCallback_t ReleaseCallback = nullptr;
+    void* UserParameter = nullptr;
+    // releaseOnLoad for AttachOwned, clearAttachedResource for Unload.
+    bool Flag = false;
+    int32_t Priority = 0;
+};
+
+class RendererResourceInternal_t;
+
+struct RendererPreload_t
+{
+    RendererResourceInternal_t* Resource;
+    int32_t Priority;
+};
+
+// A screenshot the renderer started to read back, Capture is set when it was taken for StartCapture.
+// Id tells the readbacks apart, a BeforeOverlay screenshot and the AfterOverlay one of the previous frame can be in flight together.
+struct RendererPendingScreenshot_t
+{
+    uint64_t Id;
+    uint64_t Frame;
+    bool Capture;
+};
+
+// The back buffer rectangle a screenshot reads, from the top left corner, and the size it is scaled down to.
+struct RendererScreenshotRegion_t
+{
+    uint32_t X;
+    uint32_t Y;
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t TargetWidth;
+    uint32_t TargetHeight;
+};
+
+class RendererAtlasedResourceInternal_t;
+class RendererAtlasPage_t;
+struct RendererAtlasRect_t;
+class RendererDecoderPool_t;
+
+class RendererHookInternal_t : public RendererHook_t
+{
+    ScreenshotCallback_t _ScreenshotCallback;
+    void* _ScreenshotCallbackUserParameter;
+    ScreenshotType_t _TakeScreenshotType;
+    // The rectangle asked with TakeScreenshot, an empty one reads the whole back buffer.
+    uint32_t _TakeScreenshotX;
+    uint32_t _TakeScreenshotY;
+    uint32_t _TakeScreenshotWidth;
+    uint32_t _TakeScreenshotHeight;
+    // The size asked with TakeScreenshot, 0 keeps the rectangle size.
+    uint32_t _TakeScreenshotTargetWidth;
+    uint32_t _TakeScreenshotTargetHeight;
+    ScreenshotType_t _CaptureType;
+    ScreenshotCallback_t _CaptureCallback;
+    void* _CaptureCallbackUserParameter;
+    uint32_t _CaptureRingDepth;
+    std::chrono::steady_clock::duration _CaptureInterval;
+    std::chrono::steady_clock::time_point _NextCaptureTime;
+    // Set when the last _ScreenshotType returned the type of a captured frame.
+    bool _CaptureRequested;
+    // Screenshots read back and not sent yet, in the order they were taken.
+    std::deque<RendererPendingScreenshot_t> _PendingScreenshots;
+    uint64_t _NextScreenshotId;
+    // The frame the screenshot of the last _ScreenshotType belongs to.
+    uint64_t _ScreenshotFrame;
+    std::vector<std::unique_ptr<RendererAtlasPage_t>> _AtlasPages;
+    std::unique_ptr<RendererDecoderPool_t> _DecoderPool;
+    std::atomic<std::thread::id> _RenderThreadId;
+    mpmc_bounded_queue<RendererResourceCommand_t> _ResourceCommands;
+    // The commands posted while the queue was full, in order. Once it is used, every command goes there until the render thread drains it.
+    std::mutex _ResourceCommandsOverflowMutex;
+    std::vector<RendererResourceCommand_t> _ResourceCommandsOverflow;
+    std::atomic<bool> _ResourceCommandsOverflowing;
+    bool _ProcessingResourceCommands;
+    // The texture table, the objects are owned at the same index as their slot.
+    std::vector<RendererTextureSlot_t> _TextureSlots;
+    std::vector<std::shared_ptr<RendererTexture_t>> _Textures;
+    std::vector<uint32_t> _FreeTextureSlots;
+    // Removed textures, in the order they were retired, waiting for the GPU to complete their frame.
+    std::deque<RendererTextureReleaseParameter_t> _RetiredTextures;
+    uint64_t _CompletedFrame;
+    // Loaded resources, the most recently used first.
+    std::list<RendererResourceInternal_t*> _ResidentResources;
+    uint64_t _TextureMemoryBudget;
+    uint64_t _ResidentBytes;
+    uint64_t _EvictionCount;
+    uint64_t _EvictedBytes;
+    bool _ResourceDeduplication;
+    // Resources to load before they are drawn, the highest priority first.
+    std::vector<RendererPreload_t> _Preloads;
+    std::unordered_map<RendererTextureKey_t, RendererSharedTexture_t, RendererTextureKeyHash_t> _SharedTextures;
+
+    void _EvictResidentResources();
+    // Returns the shared texture held by the resource, or nullptr if it has its own.
+    RendererSharedTexture_t* _FindSharedTexture(RendererResourceInternal_t* resource);
+
+    void _RunResourceCommand(RendererResourceCommand_t const& command);
+
+    void _PreloadInsert(RendererResourceInternal_t* resource, int32_t priority);
+
+protected:
+    uint32_t _BatchSize;
+    uint32_t _LoadByteBudget;
+    uint32_t _LoadTimeBudget;
+    // Measured upload cost, averaged over the last batches.
+    double _LoadNanosecondsPerByte;
+    std::chrono::steady_clock::time_point _LoadBatchStart;
+    uint32_t _UploadBufferSize;
+    uint64_t _CurrentFrame;
+
+    RendererHookInternal_t();
+    virtual ~RendererHookInternal_t();
+
+    // Returns the screenshot requested for this frame, or the capture type when a captured frame is due.
+    ScreenshotType_t _ScreenshotType();
+
+    // Rectangle of a sourceWidth x sourceHeight back buffer the screenshot reads, clipped to it, and the size it is scaled down to.
+    // The captured frames read the whole back buffer, an empty rectangle means the requested one was outside of it.
+    // Must be called before _BeginScreenshot.
+    RendererScreenshotRegion_t _ScreenshotRegion(uint32_t sourceWidth, uint32_t sourceHeight) const;
+
+    // Readback slots the renderers keep, enough for the capture ring depth.
+    uint32_t _ScreenshotRingDepth() const;
+
+    void _SendScreenshot(ScreenshotCallbackParameter_t* screenshot);
+
+    // Clears the screenshot request once the renderer started to read the pixels back asynchronously, returns the readback id.
+    uint64_t _BeginScreenshot();
+
+    // Sends the pixels read back asynchronously, screenshotId is the one _BeginScreenshot returned.
+    // A nullptr screenshot drops it, the renderers must call it for every _BeginScreenshot.
+    void _SendScreenshot(ScreenshotCallbackParameter_t* screenshot, uint64_t screenshotId);
+
+    // Returns how many of the first load parameters fit in the frame budget and starts timing the batch.
+    size_t _BeginLoadBatch(std::vector<RendererTextureLoadParameter_t> const& loadParameters);
+
+    // Updates the measured upload cost with the bytes uploaded since _BeginLoadBatch.
+    void _EndLoadBatch(uint64_t loadedBytes);
+
+    // Called by the renderers before OverlayProc, the calling thread becomes the render thread.
+    void _ProcessResourceCommands();
+
+    // Called by the renderers after OverlayProc, starts the loads of the preloaded resources within the batch size.
+    void _ProcessPreloads();
+
+    // Adds a texture allocated by the renderer to the table and returns its handle.
+    RendererTextureHandle_t _InsertTexture(std::shared_ptr<RendererTexture_t> texture);
+
+    // Removes a texture from the table, the renderer keeps the returned object until the GPU is done with it.
+    std::shared_ptr<RendererTexture_t> _RemoveTexture(RendererTextureHandle_t handle);
+
+    // Returns nullptr if the texture was released, used by the load paths that keep the object alive while the GPU uses it.
+    std::shared_ptr<RendererTexture_t> _GetTexture(RendererTextureHandle_t handle);
+
+    // Loaded also publishes the ImGui texture id of the renderer object.
+    void _SetTextureLoadStatus(RendererTextureHandle_t handle, RendererTextureStatus_e status);
+
+    size_t _LoadedTextureCount() const;
+
+    // Drops every texture, their renderer objects are released right away.
+    void _ClearTextures();
+
+    // Keeps the renderer object of a removed texture until the GPU completed the current frame.
+    void _RetireTexture(std::shared_ptr<RendererTexture_t> texture);
+
+    // Called by the renderers when their fences tell the GPU is done with a frame, the frames complete in order.
+    void _SetCompletedFrame(uint64_t frame);
+
+    // Destroys the retired textures of the completed frames, a limited count per call so a big unload is spread over a few frames.
+    void _ReleaseRetiredTextures();
+
+    // The GPU is idle or the device is gone, destroys every retired texture now.
+    void _ClearRetiredTextures();
+
+    size_t _RetiredTextureCount() const;
+
+public:
+    virtual void SetScreenshotCallback(ScreenshotCallback_t callback, void* userParam);
+
+    virtual uint32_t GetAutoLoadBatchSize();
+
+    virtual void SetAutoLoadBatchSize(uint32_t batchSize);
+
+    virtual uint32_t GetAutoLoadByteBudget();
+
+    virtual void SetAutoLoadByteBudget(uint32_t bytesPerFrame);
+
+    virtual uint32_t GetAutoLoadTimeBudget();
+
+    virtual void SetAutoLoadTimeBudget(uint32_t microsecondsPerFrame);
+
+    virtual uint32_t GetUploadBufferSize();
+
+    virtual void SetUploadBufferSize(uint32_t size);
+
+    virtual bool GetTextureMemoryStats(RendererTextureMemoryStats_t* stats);
+
+    virtual uint64_t GetTextureMemoryBudget();
+
+    virtual void SetTextureMemoryBudget(uint64_t bytes);
+
+    virtual void GetResidencyStats(RendererResidencyStats_t* stats);
+
+    virtual bool GetResourceDeduplication();
+
+    virtual void SetResourceDeduplication(bool enable);
+
+    virtual RendererResource_t* CreateResource();
+
+    virtual RendererResource_t* CreateAndAttachResource(const void* image_data, uint32_t width, uint32_t height);
+
+    virtual RendererResource_t* CreateAtlasedResource();
+
+    virtual RendererResource_t* CreateResourceFromEncoded(const void* data, size_t size);
+
+    virtual void Preload(RendererResource_t* const* resources, size_t count, int32_t priority);
+
+    virtual void TakeScreenshot(ScreenshotType_t type);
+
+    virtual void TakeScreenshot(ScreenshotType_t type, uint32_t width, uint32_t height);
+
+    virtual void TakeScreenshot(ScreenshotType_t type, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+    virtual bool StartCapture(uint32_t fps, ScreenshotCallback_t callback, void* userParameter, uint32_t ringDepth, ScreenshotType_t type);
+
+    virtual void StopCapture();
+
+    virtual bool IsCapturing() const;
+
+    bool IsRenderThread() const;
+
+    // Queues a resource call made from another thread, it never blocks: nothing drains the queue before the first frame or once the hook is removed.
+    void PostResourceCommand(RendererResourceCommand_t const& command);
+
+    // Queues several calls in order, before the first frame they go to the overflow list at once.
+    void PostResourceCommands(RendererResourceCommand_t const* commands, size_t count);
+
+    // Returns true if calls posted by the other threads are waiting for the next frame, false while they are replayed.
+    bool HasPendingResourceCommands() const;
+
+    // Returns nullptr if the texture was released, valid until the next texture is allocated.
+    inline RendererTextureSlot_t* GetTextureSlot(RendererTextureHandle_t handle)
+    {
+        if (!handle.IsValid() || handle.Index >= _TextureSlots.size() || _TextureSlots[handle.Index].Generation != handle.Generation)
+            return nullptr;
+
+        return &_TextureSlots[handle.Index];
+    }
+
+    virtual RendererTextureHandle_t AllocImageResource() = 0;
+
+    // Returns true if the renderer can load and sample an image of this format and size without converting it.
+    virtual bool IsResourceFormatSupported(ResourceFormat_t format, uint32_t width, uint32_t height);
+
+    virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter) = 0;
+
+    // Returns false if the renderer can't update a part of a loaded texture, the whole image is loaded again instead.
+    virtual bool UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter);
+
+    virtual void ReleaseImageResource(RendererTextureHandle_t resource) = 0;
+
+    // Returns the texture of the resources with this content, allocated by the first one. Each call takes a reference.
+    RendererTextureHandle_t AcquireSharedImageResource(RendererTextureKey_t const& key);
+
+    // Drops a reference taken by AcquireSharedImageResource, the texture is released with the last one.
+    void ReleaseSharedImageResource(RendererTextureKey_t const& key, RendererTextureHandle_t resource);
+
+    RendererAtlasPage_t* AtlasInsert(RendererAtlasedResourceInternal_t* resource, uint32_t width, uint32_t height, RendererAtlasRect_t& rect);
+
+    void AtlasRemove(RendererAtlasPage_t* page, RendererAtlasedResourceInternal_t* resource);
+
+    // Tracks a resource which load was just started, it can unload the least recently used ones to stay under the budget.
+    // A shared texture is counted once, with the bytes given by the resource that loaded it, the others pass 0.
+    void ResidencyInsert(RendererResourceInternal_t* resource, uint64_t bytes);
+
+    // Also tracks the resources drawing a shared texture another one loaded.
+    void ResidencyTouch(RendererResourceInternal_t* resource);
+
+    void ResidencyRemove(RendererResourceInternal_t* resource);
+
+    // Called when a preloaded resource is deleted.
+    void PreloadRemove(RendererResourceInternal_t* resource);
+};
+
 }
\ No newline at end of file
@@ -1,150 +1,394 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#include "InternalIncludes.h"
-#include "RendererHookInternal.h"
-#include "RendererResourceInternal.h"
-
-namespace InGameOverlay {
-
-RendererResourceInternal_t::RendererResourceInternal_t(RendererHookInternal_t* rendererHook) noexcept :
-    _RendererHook(rendererHook),
-    _Data(nullptr)
-{
-}
-
-RendererResourceInternal_t::~RendererResourceInternal_t()
-{
-    Unload();
-}
-
-void RendererResourceInternal_t::Delete()
-{
-    delete this;
-}
-
-bool RendererResourceInternal_t::IsLoaded() const
-{
-    return !_RendererResource.RendererResource.expired();
-}
-
-bool RendererResourceInternal_t::HasAttachedResource() const
-{
-    return _Data != nullptr;
-}
-
-uint64_t RendererResourceInternal_t::GetResourceId()
-{
-    if (HasAttachedResource())
-    {
-        auto r = _RendererResource.RendererResource.lock();
-        if (r == nullptr)
-        {
-            _RendererResource.RendererResource = _RendererHook->AllocImageResource();
-            r = _RendererResource.RendererResource.lock();
-        }
-
-        if (r != nullptr)
-        {
-            switch (r->LoadStatus)
-            {
-                case RendererTextureStatus_e::NotLoaded:
-                {
-                    RendererTextureLoadParameter_t loadParameter;
-                    loadParameter.Resource = _RendererResource.RendererResource;
-                    loadParameter.Data = _Data;
-                    loadParameter.Height = _RendererResource.Height;
-                    loadParameter.Width = _RendererResource.Width;
-                    r->LoadStatus = RendererTextureStatus_e::Loading;
-                    _RendererHook->LoadImageResource(loadParameter);
-                }
-                break;
-
-                case RendererTextureStatus_e::Loading: break;
-                case RendererTextureStatus_e::Loaded:
-                    if (AttachementChanged())
-                        UnloadOldResource();
-
-                    return r->ImGuiTextureId;
-            }
-        }
-    }
-    if (AttachementChanged())
-    {
-        auto r = _OldRendererResource.RendererResource.lock();
-        if (r != nullptr)
-            return r->ImGuiTextureId;
-    }
-
-    return 0;
-}
-
-uint32_t RendererResourceInternal_t::Width() const
-{
-    return IsLoaded()
-        ? _RendererResource.Width
-        : _OldRendererResource.Width;
-}
-
-uint32_t RendererResourceInternal_t::Height() const
-{
-    return IsLoaded()
-        ? _RendererResource.Height
-        : _OldRendererResource.Height;
-}
-
-void RendererResourceInternal_t::AttachResource(const void* data, uint32_t width, uint32_t height)
-{
-    if (IsLoaded())
-        _OldRendererResource = _RendererResource;
-
-    _RendererResource.RendererResource.reset();
-    _Data = data;
-    _RendererResource.Width = width;
-    _RendererResource.Height = height;
-}
-
-void RendererResourceInternal_t::ClearAttachedResource()
-{
-    _Data = nullptr;
-}
-
-void RendererResourceInternal_t::Unload(bool clearAttachedResource)
-{
-    UnloadOldResource();
-
-    _RendererHook->ReleaseImageResource(_RendererResource.RendererResource);
-    _RendererResource.Reset();
-
-    if (clearAttachedResource)
-        ClearAttachedResource();
-}
-
-bool RendererResourceInternal_t::AttachementChanged()
-{
-    return !_OldRendererResource.RendererResource.expired();
-}
-
-void RendererResourceInternal_t::UnloadOldResource()
-{
-    _RendererHook->ReleaseImageResource(_OldRendererResource.RendererResource);
-    _OldRendererResource.Reset();
-}
-
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "InternalIncludes.h"
+#include "RendererHookInternal.h"
+#include "RendererResourceInternal.h"
+#include "RendererFormatInternal.h"
+
+#include <cstring>
+
+namespace InGameOverlay {
+
+RendererResourceInternal_t::RendererResourceInternal_t(RendererHookInternal_t* rendererHook) noexcept :
+    _RendererHook(rendererHook),
+    _CallingItself(false),
+    _Data(nullptr),
+    _ReleaseDataOnLoad(false),
+    _Format(ResourceFormat_t::R8G8B8A8),
+    _GenerateMipmaps(false),
+    _Resident(false),
+    _ResidentBytes(0),
+    _LastUsedFrame(0),
+    _ContentHash(0),
+    _ContentHashed(false),
+    _Shareable(true),
+    _Preloading(false)
+{
+}
+
+RendererResourceInternal_t::~RendererResourceInternal_t()
+{
+    if (_Preloading)
+        _RendererHook->PreloadRemove(this);
+
+    _CallingItself = true;
+    Unload();
+}
+
+void RendererResourceInternal_t::Delete()
+{
+    // The calls posted before can still use the resource.
+    if (_PostCommand({ RendererResourceCommandType_e::Delete }, true))
+        return;
+
+    delete this;
+}
+
+bool RendererResourceInternal_t::IsLoaded() const
+{
+    return _RendererHook->GetTextureSlot(_RendererResource.RendererResource) != nullptr;
+}
+
+bool RendererResourceInternal_t::HasAttachedResource() const
+{
+    return _Data != nullptr;
+}
+
+uint64_t RendererResourceInternal_t::GetResourceId()
+{
+    auto r = _RendererHook->GetTextureSlot(_RendererResource.RendererResource);
+    if (r == nullptr && _Data != nullptr)
+    {
+        _RendererHook->ResidencyRemove(this);
+        if (_RendererResource.Shared)
+        {
+            // The renderer released the shared texture, drop our reference on it.
+            _ReleaseTexture(_RendererResource);
+        }
+
+        if (_Shareable && _RendererHook->GetResourceDeduplication())
+        {
+            if (!_ContentHashed)
+            {
+                _ContentHash = HashResourceData(_Data, GetResourceFormatDataSize(_Format, _RendererResource.Width, _RendererResource.Height));
+                _ContentHashed = true;
+            }
+
+            auto& key = _RendererResource.SharedKey;
+            key.Hash = _ContentHash;
+            key.Width = _RendererResource.Width;
+            key.Height = _RendererResource.Height;
+            key.Format = _Format;
+            key.GenerateMipmaps = _GenerateMipmaps;
+            _RendererResource.Shared = true;
+            _RendererResource.RendererResource = _RendererHook->AcquireSharedImageResource(key);
+        }
+        else
+        {
+            _RendererResource.RendererResource = _RendererHook->AllocImageResource();
+        }
+        r = _RendererHook->GetTextureSlot(_RendererResource.RendererResource);
+    }
+
+    if (r != nullptr)
+    {
+        switch (r->LoadStatus)
+        {
+            case RendererTextureStatus_e::NotLoaded:
+            {
+                if (_Data == nullptr)
+                    break;
+
+                RendererTextureLoadParameter_t loadParameter;
+                loadParameter.Resource = _RendererResource.RendererResource;
+                loadParameter.Data = _Data;
+                loadParameter.DataOwner = _DataOwner;
+                loadParameter.Height = _RendererResource.Height;
+                loadParameter.Width = _RendererResource.Width;
+                loadParameter.Format = _Format;
+                if (_Format != ResourceFormat_t::R8G8B8A8 && !_RendererHook->IsResourceFormatSupported(_Format, _RendererResource.Width, _RendererResource.Height))
+                {
+                    // The renderer can't sample it, load an R8G8B8A8 copy instead.
+                    auto pixels = std::make_shared<std::vector<uint8_t>>(size_t(loadParameter.Width) * loadParameter.Height * 4);
+                    if (!ConvertResourceData(_Format, _Data, loadParameter.Width, loadParameter.Height, pixels->data()))
+                        break;
+
+                    loadParameter.Data = pixels->data();
+                    loadParameter.DataOwner = std::move(pixels);
+                    loadParameter.Format = ResourceFormat_t::R8G8B8A8;
+                }
+                loadParameter.GenerateMipmaps = _GenerateMipmaps && !IsResourceFormatCompressed(loadParameter.Format);
+                r->LoadStatus = RendererTextureStatus_e::Loading;
+                _RendererHook->LoadImageResource(loadParameter);
+
+                auto bytes = uint64_t(GetResourceFormatDataSize(loadParameter.Format, loadParameter.Width, loadParameter.Height));
+                if (loadParameter.GenerateMipmaps)
+                    bytes += bytes / 3;
+
+                _RendererHook->ResidencyInsert(this, bytes);
+            }
+            break;
+
+            case RendererTextureStatus_e::Loading:
+                _RendererHook->ResidencyTouch(this);
+                break;
+
+            case RendererTextureStatus_e::Loaded:
+                _RendererHook->ResidencyTouch(this);
+                if (AttachementChanged())
+                    UnloadOldResource();
+
+                // The data released on load is not attached anymore but the texture is still valid.
+                DataLoaded();
+                return r->ImGuiTextureId;
+        }
+    }
+    if (AttachementChanged())
+    {
+        auto r = _RendererHook->GetTextureSlot(_OldRendererResource.RendererResource);
+        if (r != nullptr)
+            return r->ImGuiTextureId;
+    }
+
+    return 0;
+}
+
+uint32_t RendererResourceInternal_t::Width() const
+{
+    return IsLoaded()
+        ? _RendererResource.Width
+        : _OldRendererResource.Width;
+}
+
+uint32_t RendererResourceInternal_t::Height() const
+{
+    return IsLoaded()
+        ? _RendererResource.Height
+        : _OldRendererResource.Height;
+}
+
+ResourceUV_t RendererResourceInternal_t::GetResourceUV() const
+{
+    return ResourceUV_t{ 0.0f, 0.0f, 1.0f, 1.0f };
+}
+
+void RendererResourceInternal_t::AttachResource(const void* data, uint32_t width, uint32_t height)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::Attach, nullptr, data, width, height }, true))
+        return;
+
+    _RendererHook->ResidencyRemove(this);
+    if (IsLoaded())
+    {
+        // Attached again before the previous attachement was loaded.
+        UnloadOldResource();
+        _OldRendererResource = _RendererResource;
+    }
+    else
+    {
+        _ReleaseTexture(_RendererResource);
+    }
+
+    _RendererResource.RendererResource = RendererTextureHandle_t{};
+    _RendererResource.Shared = false;
+    _ContentHashed = false;
+    _Shareable = true;
+    _Data = data;
+    _DataOwner.reset();
+    _ReleaseDataOnLoad = false;
+    _Format = ResourceFormat_t::R8G8B8A8;
+    _RendererResource.Width = width;
+    _RendererResource.Height = height;
+}
+
+void RendererResourceInternal_t::AttachResource(void* data, uint32_t width, uint32_t height, ResourceDataReleaseCallback_t releaseCallback, void* userParameter, bool releaseOnLoad)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::AttachOwned, nullptr, data, width, height, ResourceFormat_t::R8G8B8A8, releaseCallback, userParameter, releaseOnLoad }, true))
+        return;
+
+    std::shared_ptr<void> dataOwner;
+    if (data != nullptr && releaseCallback != nullptr)
+    {
+        dataOwner = std::shared_ptr<void>(data, [releaseCallback, userParameter](void* p)
+        {
+            releaseCallback(p, userParameter);
+        });
+    }
+
+    // Drops the previously owned data.
+    AttachResource(static_cast<const void*>(data), width, height);
+
+    if (dataOwner != nullptr)
+    {
+        _DataOwner = std::move(dataOwner);
+        _ReleaseDataOnLoad = releaseOnLoad;
+    }
+}
+
+void RendererResourceInternal_t::AttachResource(const void* data, uint32_t width, uint32_t height, ResourceFormat_t format)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::AttachFormatted, nullptr, data, width, height, format }, true))
+        return;
+
+    RendererResourceInternal_t::AttachResource(data, width, height);
+    _Format = format;
+}
+
+void RendererResourceInternal_t::UpdateRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t pitch)
+{
+    // Written so x + width can't wrap around.
+    if (data == nullptr || width == 0 || height == 0 || _Format != ResourceFormat_t::R8G8B8A8 ||
+        x > _RendererResource.Width || width > _RendererResource.Width - x ||
+        y > _RendererResource.Height || height > _RendererResource.Height - y)
+        return;
+
+    // Not loaded yet, the attached data will be used.
+    auto r = _RendererHook->GetTextureSlot(_RendererResource.RendererResource);
+    if (r == nullptr || r->LoadStatus != RendererTextureStatus_e::Loaded)
+        return;
+
+    // The other resources sharing the texture keep their content, load the attached data in a texture of our own.
+    if (_RendererResource.Shared)
+    {
+        _ReloadUnshared();
+        return;
+    }
+
+    const uint32_t rowSize = width * 4;
+    if (pitch == 0)
+        pitch = rowSize;
+
+    RendererTextureUpdateParameter_t updateParameter;
+    updateParameter.Resource = _RendererResource.RendererResource;
+    updateParameter.X = x;
+    updateParameter.Y = y;
+    updateParameter.Width = width;
+    updateParameter.Height = height;
+    updateParameter.Data.resize(size_t(rowSize) * height);
+    for (uint32_t i = 0; i < height; ++i)
+        memcpy(updateParameter.Data.data() + size_t(i) * rowSize, reinterpret_cast<const uint8_t*>(data) + size_t(i) * pitch, rowSize);
+
+    if (!_RendererHook->UpdateImageResource(updateParameter))
+    {
+        _ReloadUnshared();
+        return;
+    }
+
+    _Shareable = false;
+}
+
+void RendererResourceInternal_t::_ReloadUnshared()
+{
+    if (_Data != nullptr)
+    {
+        // Load the attached data again, it stays owned.
+        auto dataOwner = std::move(_DataOwner);
+        const auto releaseDataOnLoad = _ReleaseDataOnLoad;
+        _CallingItself = true;
+        RendererResourceInternal_t::AttachResource(_Data, _RendererResource.Width, _RendererResource.Height);
+        _CallingItself = false;
+        _DataOwner = std::move(dataOwner);
+        _ReleaseDataOnLoad = releaseDataOnLoad;
+    }
+
+    _Shareable = false;
+}
+
+void RendererResourceInternal_t::ClearAttachedResource()
+{
+    _Data = nullptr;
+    _DataOwner.reset();
+    _ReleaseDataOnLoad = false;
+    _Format = ResourceFormat_t::R8G8B8A8;
+}
+
+void RendererResourceInternal_t::Unload(bool clearAttachedResource)
+{
+    if (_PostCommand({ RendererResourceCommandType_e::Unload, nullptr, nullptr, 0, 0, ResourceFormat_t::R8G8B8A8, nullptr, nullptr, clearAttachedResource }, true))
+        return;
+
+    UnloadOldResource();
+
+    _RendererHook->ResidencyRemove(this);
+    _ReleaseTexture(_RendererResource);
+    _RendererResource.Reset();
+
+    if (clearAttachedResource)
+        ClearAttachedResource();
+}
+
+void RendererResourceInternal_t::SetGenerateMipmaps(bool generate)
+{
+    _GenerateMipmaps = generate;
+}
+
+bool RendererResourceInternal_t::GetGenerateMipmaps() const
+{
+    return _GenerateMipmaps;
+}
+
+bool RendererResourceInternal_t::AttachementChanged()
+{
+    return _RendererHook->GetTextureSlot(_OldRendererResource.RendererResource) != nullptr;
+}
+
+void RendererResourceInternal_t::UnloadOldResource()
+{
+    _ReleaseTexture(_OldRendererResource);
+    _OldRendererResource.Reset();
+}
+
+void RendererResourceInternal_t::DataLoaded()
+{
+    if (_ReleaseDataOnLoad && _DataOwner != nullptr)
+        ClearAttachedResource();
+}
+
+void RendererResourceInternal_t::Evict()
+{
+    UnloadOldResource();
+
+    // Keeps the size of the attached data, only the texture is released.
+    _RendererHook->ResidencyRemove(this);
+    _ReleaseTexture(_RendererResource);
+}
+
+bool RendererResourceInternal_t::_PostCommand(RendererResourceCommand_t command, bool keepOrder)
+{
+    if (_RendererHook->IsRenderThread() && !(keepOrder && !_CallingItself && _RendererHook->HasPendingResourceCommands()))
+        return false;
+
+    command.Resource = this;
+    _RendererHook->PostResourceCommand(command);
+    return true;
+}
+
+void RendererResourceInternal_t::_ReleaseTexture(ResourceState_t& state)
+{
+    if (state.Shared)
+        _RendererHook->ReleaseSharedImageResource(state.SharedKey, state.RendererResource);
+    else
+        _RendererHook->ReleaseImageResource(state.RendererResource);
+
+    state.RendererResource = RendererTextureHandle_t{};
+    state.Shared = false;
+}
+
 }
\ No newline at end of file
@@ -1,87 +1,140 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#pragma once
-
-#include <memory>
-
-#include "InternalIncludes.h"
-
-namespace InGameOverlay {
-
-class RendererHookInternal_t;
-
-struct ResourceState_t
-{
-    std::weak_ptr<RendererTexture_t> RendererResource;
-    uint32_t Width = 0;
-    uint32_t Height = 0;
-
-    inline void Reset()
-    {
-        RendererResource.reset();
-        Width = 0;
-        Height = 0;
-    }
-};
-
-class RendererResourceInternal_t : public RendererResource_t
-{
-protected:
-    RendererHookInternal_t* _RendererHook;
-
-public:
-    ResourceState_t _OldRendererResource;
-    ResourceState_t _RendererResource;
-    const void* _Data;
-
-    RendererResourceInternal_t(RendererHookInternal_t* rendererHook) noexcept;
-
-    RendererResourceInternal_t(RendererResourceInternal_t &&) noexcept = default;
-    RendererResourceInternal_t& operator=(RendererResourceInternal_t &&) noexcept = default;
-
-    RendererResourceInternal_t(RendererResourceInternal_t const&) = delete;
-    RendererResourceInternal_t& operator=(RendererResourceInternal_t const&) = delete;
-
-    virtual ~RendererResourceInternal_t();
-
-    virtual void Delete();
-
-    virtual bool IsLoaded() const;
-
-    virtual bool HasAttachedResource() const;
-
-    virtual uint64_t GetResourceId();
-
-    virtual uint32_t Width() const;
-
-    virtual uint32_t Height() const;
-
-    virtual void AttachResource(const void* data, uint32_t width, uint32_t height);
-
-    virtual void ClearAttachedResource();
-
-    virtual void Unload(bool clearAttachedResource = true);
-
-    bool AttachementChanged();
-
-    void UnloadOldResource();
-};
-
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+
+#include "InternalIncludes.h"
+
+namespace InGameOverlay {
+
+class RendererHookInternal_t;
+
+struct ResourceState_t
+{
+    RendererTextureHandle_t RendererResource;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    // Set when the texture is shared with the resources of the same content.
+    RendererTextureKey_t SharedKey;
+    bool Shared = false;
+
+    inline void Reset()
+    {
+        RendererResource = RendererTextureHandle_t{};
+        Width = 0;
+        Height = 0;
+        Shared = false;
+    }
+};
+
+class RendererResourceInternal_t : public RendererResource_t
+{
+protected:
+    RendererHookInternal_t* _RendererHook;
+
+    // Releases the texture of the state, or the reference on it if it is shared.
+    void _ReleaseTexture(ResourceState_t& state);
+
+    // Loads the attached data again in a texture that is not shared.
+    void _ReloadUnshared();
+
+    // Returns true if the call was made outside of the render thread and posted to it instead.
+    // keepOrder also posts it from the render thread while calls posted before are waiting.
+    bool _PostCommand(RendererResourceCommand_t command, bool keepOrder = false);
+
+    // Set while the resource calls its own methods on the render thread, they are never posted.
+    bool _CallingItself;
+
+public:
+    ResourceState_t _OldRendererResource;
+    ResourceState_t _RendererResource;
+    const void* _Data;
+    // Set when the resource owns _Data, the release callback is called once the last reference is dropped.
+    std::shared_ptr<void> _DataOwner;
+    bool _ReleaseDataOnLoad;
+    ResourceFormat_t _Format;
+    bool _GenerateMipmaps;
+    // Position in the renderer least recently used list while the texture is loaded.
+    std::list<RendererResourceInternal_t*>::iterator _ResidencyIterator;
+    bool _Resident;
+    uint64_t _ResidentBytes;
+    uint64_t _LastUsedFrame;
+    // Hash of the attached data, computed on its first load when the deduplication is enabled.
+    uint64_t _ContentHash;
+    bool _ContentHashed;
+    // Cleared once the texture was updated, the content doesn't match the attached data anymore.
+    bool _Shareable;
+    // Set while the resource is in the renderer preload list.
+    bool _Preloading;
+
+    RendererResourceInternal_t(RendererHookInternal_t* rendererHook) noexcept;
+
+    RendererResourceInternal_t(RendererResourceInternal_t &&) noexcept = default;
+    RendererResourceInternal_t& operator=(RendererResourceInternal_t &&) noexcept = default;
+
+    RendererResourceInternal_t(RendererResourceInternal_t const&) = delete;
+    RendererResourceInternal_t& operator=(RendererResourceInternal_t const&) = delete;
+
+    virtual ~RendererResourceInternal_t();
+
+    virtual void Delete();
+
+    virtual bool IsLoaded() const;
+
+    virtual bool HasAttachedResource() const;
+
+    virtual uint64_t GetResourceId();
+
+    virtual uint32_t Width() const;
+
+    virtual uint32_t Height() const;
+
+    virtual ResourceUV_t GetResourceUV() const;
+
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height);
+
+    virtual void AttachResource(void* data, uint32_t width, uint32_t height, ResourceDataReleaseCallback_t releaseCallback, void* userParameter, bool releaseOnLoad);
+
+    virtual void AttachResource(const void* data, uint32_t width, uint32_t height, ResourceFormat_t format);
+
+    virtual void UpdateRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t pitch);
+
+    virtual void ClearAttachedResource();
+
+    virtual void Unload(bool clearAttachedResource = true);
+
+    virtual void SetGenerateMipmaps(bool generate);
+
+    virtual bool GetGenerateMipmaps() const;
+
+    bool AttachementChanged();
+
+    void UnloadOldResource();
+
+    // Releases the owned data if it was attached with releaseOnLoad, called once the resource is loaded.
+    void DataLoaded();
+
+    // Releases the texture but keeps the attached data, the next GetResourceId loads it again.
+    void Evict();
+};
+
 }
\ No newline at end of file
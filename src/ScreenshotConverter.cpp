@@ -0,0 +1,918 @@
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <InGameOverlay/ScreenshotConverter.h>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define INGAMEOVERLAY_CONVERTER_SSE2
+    #include <emmintrin.h>
+
+    // The AVX2 kernels are compiled for their own target and only called when the CPU has it.
+    #define INGAMEOVERLAY_CONVERTER_AVX2
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define INGAMEOVERLAY_TARGET_AVX2
+    #else
+        #include <cpuid.h>
+        #define INGAMEOVERLAY_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define INGAMEOVERLAY_CONVERTER_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace InGameOverlay {
+
+// The formats are converted by families, the channels are read in the order they are stored: c0 is the first byte or the low bits.
+enum class ConverterFamily_e : uint8_t
+{
+    Unknown,
+    Rgba8,
+    Rgb8,
+    Rgb10A2,
+    R5G6B5,
+    R5G5B5A1,
+    Rgba16Unorm,
+    Rgba16Float,
+    Rgba32Float,
+};
+
+struct ConverterLayout_t
+{
+    ConverterFamily_e Family;
+    // Set when c0 is the blue channel.
+    bool SourceBgr;
+    // Set when the alpha bits are not used, the alpha is written as 255.
+    bool Opaque;
+};
+
+// Converts width pixels of a row, swap writes c0 in the third byte and c2 in the first one.
+typedef void (*RowConverter_t)(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque);
+
+static ConverterLayout_t GetConverterLayout(ScreenshotDataFormat_t format)
+{
+    switch (format)
+    {
+        case ScreenshotDataFormat_t::R8G8B8            : return { ConverterFamily_e::Rgb8       , true , true  };
+        case ScreenshotDataFormat_t::X8R8G8B8          : return { ConverterFamily_e::Rgba8      , true , true  };
+        case ScreenshotDataFormat_t::A8R8G8B8          : return { ConverterFamily_e::Rgba8      , true , false };
+        case ScreenshotDataFormat_t::B8G8R8A8          : return { ConverterFamily_e::Rgba8      , true , false };
+        case ScreenshotDataFormat_t::B8G8R8X8          : return { ConverterFamily_e::Rgba8      , true , true  };
+        case ScreenshotDataFormat_t::R8G8B8A8          : return { ConverterFamily_e::Rgba8      , false, false };
+        case ScreenshotDataFormat_t::A2R10G10B10       : return { ConverterFamily_e::Rgb10A2    , true , false };
+        case ScreenshotDataFormat_t::A2B10G10R10       : return { ConverterFamily_e::Rgb10A2    , false, false };
+        case ScreenshotDataFormat_t::R10G10B10A2       : return { ConverterFamily_e::Rgb10A2    , false, false };
+        case ScreenshotDataFormat_t::R5G6B5            : return { ConverterFamily_e::R5G6B5     , true , true  };
+        case ScreenshotDataFormat_t::B5G6R5            : return { ConverterFamily_e::R5G6B5     , true , true  };
+        case ScreenshotDataFormat_t::X1R5G5B5          : return { ConverterFamily_e::R5G5B5A1   , true , true  };
+        case ScreenshotDataFormat_t::A1R5G5B5          : return { ConverterFamily_e::R5G5B5A1   , true , false };
+        case ScreenshotDataFormat_t::B5G5R5A1          : return { ConverterFamily_e::R5G5B5A1   , true , false };
+        case ScreenshotDataFormat_t::R16G16B16A16_FLOAT: return { ConverterFamily_e::Rgba16Float, false, false };
+        case ScreenshotDataFormat_t::R16G16B16A16_UNORM: return { ConverterFamily_e::Rgba16Unorm, false, false };
+        case ScreenshotDataFormat_t::R32G32B32A32_FLOAT: return { ConverterFamily_e::Rgba32Float, false, false };
+        default:                                         return { ConverterFamily_e::Unknown    , false, false };
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// Scalar
+
+static inline void StorePixel(uint8_t* dst, uint32_t c0, uint32_t c1, uint32_t c2, uint32_t a, bool swap, bool opaque)
+{
+    dst[swap ? 2 : 0] = static_cast<uint8_t>(c0);
+    dst[1] = static_cast<uint8_t>(c1);
+    dst[swap ? 0 : 2] = static_cast<uint8_t>(c2);
+    dst[3] = opaque ? 255 : static_cast<uint8_t>(a);
+}
+
+static inline uint32_t Read16(const uint8_t* src)
+{
+    return src[0] | (src[1] << 8);
+}
+
+static inline uint32_t Read32(const uint8_t* src)
+{
+    return src[0] | (src[1] << 8) | (src[2] << 16) | (uint32_t(src[3]) << 24);
+}
+
+// Rounded to the nearest, v * 255 / 1023.
+static inline uint32_t Unorm10ToUnorm8(uint32_t value)
+{
+    return (value * 1021 + 2041) >> 12;
+}
+
+// Rounded to the nearest, v * 255 / 65535.
+static inline uint32_t Unorm16ToUnorm8(uint32_t value)
+{
+    return ((value << 8) - value + 32895) >> 16;
+}
+
+static inline uint32_t HalfToUnorm8(uint32_t half)
+{
+    // Negative values are clamped to 0, the infinities and NaNs to 255.
+    if (half & 0x8000)
+        return 0;
+
+    const uint32_t exponent = (half >> 10) & 0x1f;
+    const uint32_t mantissa = half & 0x3ff;
+    if (exponent >= 15)
+        return 255;
+
+    // value = (1024 + mantissa) * 2^(exponent - 25), or mantissa * 2^-24 for the denormals.
+    const uint32_t significand = exponent == 0 ? mantissa : (1024 + mantissa);
+    const uint32_t shift = exponent == 0 ? 24 : 25 - exponent;
+    return static_cast<uint32_t>((uint64_t(significand) * 255 + (uint64_t(1) << (shift - 1))) >> shift);
+}
+
+static inline uint32_t FloatToUnorm8(float value)
+{
+    // Written like the SIMD min/max, the NaNs become 0.
+    value = value > 0.0f ? value : 0.0f;
+    value = value < 1.0f ? value : 1.0f;
+    return static_cast<uint32_t>(value * 255.0f + 0.5f);
+}
+
+static void ConvertRgba8_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 4, dst += 4)
+        StorePixel(dst, src[0], src[1], src[2], src[3], swap, opaque);
+}
+
+static void ConvertRgb8_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool /*opaque*/)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 3, dst += 4)
+        StorePixel(dst, src[0], src[1], src[2], 255, swap, true);
+}
+
+static void ConvertRgb10A2_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 4, dst += 4)
+    {
+        const uint32_t color = Read32(src);
+        StorePixel(dst,
+            Unorm10ToUnorm8(color & 0x3ff),
+            Unorm10ToUnorm8((color >> 10) & 0x3ff),
+            Unorm10ToUnorm8((color >> 20) & 0x3ff),
+            (color >> 30) * 85,
+            swap, opaque);
+    }
+}
+
+static void ConvertR5G6B5_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool /*opaque*/)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 2, dst += 4)
+    {
+        const uint32_t color = Read16(src);
+        const uint32_t c0 = color & 0x1f;
+        const uint32_t c1 = (color >> 5) & 0x3f;
+        const uint32_t c2 = color >> 11;
+        // Replicates the high bits in the low bits, so 0x1f and 0x3f become 0xff.
+        StorePixel(dst, (c0 << 3) | (c0 >> 2), (c1 << 2) | (c1 >> 4), (c2 << 3) | (c2 >> 2), 255, swap, true);
+    }
+}
+
+static void ConvertR5G5B5A1_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 2, dst += 4)
+    {
+        const uint32_t color = Read16(src);
+        const uint32_t c0 = color & 0x1f;
+        const uint32_t c1 = (color >> 5) & 0x1f;
+        const uint32_t c2 = (color >> 10) & 0x1f;
+        StorePixel(dst, (c0 << 3) | (c0 >> 2), (c1 << 3) | (c1 >> 2), (c2 << 3) | (c2 >> 2), (color >> 15) * 255, swap, opaque);
+    }
+}
+
+static void ConvertRgba16Unorm_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 8, dst += 4)
+    {
+        StorePixel(dst,
+            Unorm16ToUnorm8(Read16(src)),
+            Unorm16ToUnorm8(Read16(src + 2)),
+            Unorm16ToUnorm8(Read16(src + 4)),
+            Unorm16ToUnorm8(Read16(src + 6)),
+            swap, opaque);
+    }
+}
+
+static void ConvertRgba16Float_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 8, dst += 4)
+    {
+        StorePixel(dst,
+            HalfToUnorm8(Read16(src)),
+            HalfToUnorm8(Read16(src + 2)),
+            HalfToUnorm8(Read16(src + 4)),
+            HalfToUnorm8(Read16(src + 6)),
+            swap, opaque);
+    }
+}
+
+static void ConvertRgba32Float_Scalar(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    for (uint32_t i = 0; i < width; ++i, src += 16, dst += 4)
+    {
+        float color[4];
+        memcpy(color, src, sizeof(color));
+        StorePixel(dst, FloatToUnorm8(color[0]), FloatToUnorm8(color[1]), FloatToUnorm8(color[2]), FloatToUnorm8(color[3]), swap, opaque);
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// SSE2
+
+#if defined(INGAMEOVERLAY_CONVERTER_SSE2)
+
+// Swaps the bytes 0 and 2 of each pixel if needed and sets the opaque alpha bits.
+static inline __m128i FinishPixels_SSE2(__m128i colors, bool swap, __m128i alpha)
+{
+    if (swap)
+    {
+        const __m128i greenAlphaMask = _mm_set1_epi32(static_cast<int>(0xff00ff00));
+        const __m128i redBlue = _mm_andnot_si128(greenAlphaMask, colors);
+        colors = _mm_or_si128(_mm_and_si128(colors, greenAlphaMask), _mm_or_si128(_mm_slli_epi32(redBlue, 16), _mm_srli_epi32(redBlue, 16)));
+    }
+    return _mm_or_si128(colors, alpha);
+}
+
+static inline __m128i OpaqueAlpha_SSE2(bool opaque)
+{
+    return _mm_set1_epi32(opaque ? static_cast<int>(0xff000000) : 0);
+}
+
+static inline __m128i HalfToUnorm8_SSE2(__m128i halves)
+{
+    // Rebiases the half exponent to a float one, the denormals come out right too.
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128i signMask = _mm_set1_epi32(0x8000);
+
+    __m128 value = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x7fff)), 13)), magic);
+    // Negative values are clamped to 0, the infinities and NaNs are big finite values here and clamped to 255.
+    value = _mm_min_ps(value, _mm_set1_ps(1.0f));
+    value = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(halves, signMask), signMask)), value);
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+}
+
+static inline __m128i Unorm16ToUnorm8_SSE2(__m128i values)
+{
+    return _mm_srli_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(values, 8), values), _mm_set1_epi32(32895)), 16);
+}
+
+static inline __m128i FloatToUnorm8_SSE2(__m128 values)
+{
+    // _mm_max_ps returns its second operand for the NaNs.
+    values = _mm_min_ps(_mm_max_ps(values, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(values, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+}
+
+static void ConvertRgba8_SSE2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m128i alpha = OpaqueAlpha_SSE2(opaque);
+    uint32_t i = 0;
+    for (; i + 4 <= width; i += 4)
+    {
+        const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), FinishPixels_SSE2(colors, swap, alpha));
+    }
+
+    ConvertRgba8_Scalar(src + i * 4, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgb10A2_SSE2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m128i alpha = OpaqueAlpha_SSE2(opaque);
+    const __m128i tenBitsMask = _mm_set1_epi32(0x3ff);
+    // The channels fit in the low 16 bits of their lane, _mm_madd_epi16 multiplies them in 32 bits.
+    const __m128i scale = _mm_set1_epi32(1021);
+    const __m128i bias = _mm_set1_epi32(2041);
+    const __m128i alphaScale = _mm_set1_epi32(85);
+    uint32_t i = 0;
+    for (; i + 4 <= width; i += 4)
+    {
+        const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i c0 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_and_si128(colors, tenBitsMask), scale), bias), 12);
+        const __m128i c1 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_and_si128(_mm_srli_epi32(colors, 10), tenBitsMask), scale), bias), 12);
+        const __m128i c2 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_and_si128(_mm_srli_epi32(colors, 20), tenBitsMask), scale), bias), 12);
+        const __m128i a = _mm_madd_epi16(_mm_srli_epi32(colors, 30), alphaScale);
+
+        const __m128i pixels = _mm_or_si128(_mm_or_si128(c0, _mm_slli_epi32(c1, 8)), _mm_or_si128(_mm_slli_epi32(c2, 16), _mm_slli_epi32(a, 24)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), FinishPixels_SSE2(pixels, swap, alpha));
+    }
+
+    ConvertRgb10A2_Scalar(src + i * 4, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertR5G6B5_SSE2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m128i alpha = OpaqueAlpha_SSE2(true);
+    const __m128i fiveBitsMask = _mm_set1_epi16(0x1f);
+    const __m128i sixBitsMask = _mm_set1_epi16(0x3f);
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        const __m128i c0 = _mm_and_si128(colors, fiveBitsMask);
+        const __m128i c1 = _mm_and_si128(_mm_srli_epi16(colors, 5), sixBitsMask);
+        const __m128i c2 = _mm_srli_epi16(colors, 11);
+
+        // Replicates the high bits in the low bits, so 0x1f and 0x3f become 0xff.
+        const __m128i c08 = _mm_or_si128(_mm_slli_epi16(c0, 3), _mm_srli_epi16(c0, 2));
+        const __m128i c18 = _mm_or_si128(_mm_slli_epi16(c1, 2), _mm_srli_epi16(c1, 4));
+        const __m128i c28 = _mm_or_si128(_mm_slli_epi16(c2, 3), _mm_srli_epi16(c2, 2));
+
+        const __m128i low = _mm_or_si128(c08, _mm_slli_epi16(c18, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4)     , FinishPixels_SSE2(_mm_unpacklo_epi16(low, c28), swap, alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + 16), FinishPixels_SSE2(_mm_unpackhi_epi16(low, c28), swap, alpha));
+    }
+
+    ConvertR5G6B5_Scalar(src + i * 2, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertR5G5B5A1_SSE2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m128i alpha = OpaqueAlpha_SSE2(opaque);
+    const __m128i fiveBitsMask = _mm_set1_epi16(0x1f);
+    const __m128i alphaMask = _mm_set1_epi16(static_cast<short>(0xff00));
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        const __m128i c0 = _mm_and_si128(colors, fiveBitsMask);
+        const __m128i c1 = _mm_and_si128(_mm_srli_epi16(colors, 5), fiveBitsMask);
+        const __m128i c2 = _mm_and_si128(_mm_srli_epi16(colors, 10), fiveBitsMask);
+        // The alpha bit is extended to the whole word, its high byte is the alpha.
+        const __m128i a = _mm_and_si128(_mm_srai_epi16(colors, 15), alphaMask);
+
+        const __m128i c08 = _mm_or_si128(_mm_slli_epi16(c0, 3), _mm_srli_epi16(c0, 2));
+        const __m128i c18 = _mm_or_si128(_mm_slli_epi16(c1, 3), _mm_srli_epi16(c1, 2));
+        const __m128i c28 = _mm_or_si128(_mm_slli_epi16(c2, 3), _mm_srli_epi16(c2, 2));
+
+        const __m128i low = _mm_or_si128(c08, _mm_slli_epi16(c18, 8));
+        const __m128i high = _mm_or_si128(c28, a);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4)     , FinishPixels_SSE2(_mm_unpacklo_epi16(low, high), swap, alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + 16), FinishPixels_SSE2(_mm_unpackhi_epi16(low, high), swap, alpha));
+    }
+
+    ConvertR5G5B5A1_Scalar(src + i * 2, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgba16Unorm_SSE2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m128i alpha = OpaqueAlpha_SSE2(opaque);
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t i = 0;
+    for (; i + 4 <= width; i += 4)
+    {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8 + 16));
+        const __m128i words0 = _mm_packs_epi32(Unorm16ToUnorm8_SSE2(_mm_unpacklo_epi16(first, zero)), Unorm16ToUnorm8_SSE2(_mm_unpackhi_epi16(first, zero)));
+        const __m128i words1 = _mm_packs_epi32(Unorm16ToUnorm8_SSE2(_mm_unpacklo_epi16(second, zero)), Unorm16ToUnorm8_SSE2(_mm_unpackhi_epi16(second, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), FinishPixels_SSE2(_mm_packus_epi16(words0, words1), swap, alpha));
+    }
+
+    ConvertRgba16Unorm_Scalar(src + i * 8, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgba16Float_SSE2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m128i alpha = OpaqueAlpha_SSE2(opaque);
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t i = 0;
+    for (; i + 4 <= width; i += 4)
+    {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8 + 16));
+        const __m128i words0 = _mm_packs_epi32(HalfToUnorm8_SSE2(_mm_unpacklo_epi16(first, zero)), HalfToUnorm8_SSE2(_mm_unpackhi_epi16(first, zero)));
+        const __m128i words1 = _mm_packs_epi32(HalfToUnorm8_SSE2(_mm_unpacklo_epi16(second, zero)), HalfToUnorm8_SSE2(_mm_unpackhi_epi16(second, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), FinishPixels_SSE2(_mm_packus_epi16(words0, words1), swap, alpha));
+    }
+
+    ConvertRgba16Float_Scalar(src + i * 8, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgba32Float_SSE2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m128i alpha = OpaqueAlpha_SSE2(opaque);
+    uint32_t i = 0;
+    for (; i + 4 <= width; i += 4)
+    {
+        const float* colors = reinterpret_cast<const float*>(src + i * 16);
+        const __m128i words0 = _mm_packs_epi32(FloatToUnorm8_SSE2(_mm_loadu_ps(colors))    , FloatToUnorm8_SSE2(_mm_loadu_ps(colors + 4)));
+        const __m128i words1 = _mm_packs_epi32(FloatToUnorm8_SSE2(_mm_loadu_ps(colors + 8)), FloatToUnorm8_SSE2(_mm_loadu_ps(colors + 12)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), FinishPixels_SSE2(_mm_packus_epi16(words0, words1), swap, alpha));
+    }
+
+    ConvertRgba32Float_Scalar(src + i * 16, dst + i * 4, width - i, swap, opaque);
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////
+// AVX2
+
+#if defined(INGAMEOVERLAY_CONVERTER_AVX2)
+
+static bool CpuSupportsAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // The OS must save the YMM registers too.
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, nullptr) < 7)
+        return false;
+
+    // The OS must save the YMM registers too.
+    __cpuid(1, eax, ebx, ecx, edx);
+    if ((ecx & (1u << 27)) == 0 || (ecx & (1u << 28)) == 0)
+        return false;
+
+    uint32_t xcr0Low, xcr0High;
+    __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    if ((xcr0Low & 6) != 6)
+        return false;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 5)) != 0;
+#endif
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static inline __m256i FinishPixels_AVX2(__m256i colors, bool swap, __m256i alpha)
+{
+    if (swap)
+    {
+        const __m256i greenAlphaMask = _mm256_set1_epi32(static_cast<int>(0xff00ff00));
+        const __m256i redBlue = _mm256_andnot_si256(greenAlphaMask, colors);
+        colors = _mm256_or_si256(_mm256_and_si256(colors, greenAlphaMask), _mm256_or_si256(_mm256_slli_epi32(redBlue, 16), _mm256_srli_epi32(redBlue, 16)));
+    }
+    return _mm256_or_si256(colors, alpha);
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static inline __m256i OpaqueAlpha_AVX2(bool opaque)
+{
+    return _mm256_set1_epi32(opaque ? static_cast<int>(0xff000000) : 0);
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static inline __m256i HalfToUnorm8_AVX2(__m256i halves)
+{
+    const __m256 magic = _mm256_castsi256_ps(_mm256_set1_epi32((254 - 15) << 23));
+    const __m256i signMask = _mm256_set1_epi32(0x8000);
+
+    __m256 value = _mm256_mul_ps(_mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(halves, _mm256_set1_epi32(0x7fff)), 13)), magic);
+    value = _mm256_min_ps(value, _mm256_set1_ps(1.0f));
+    value = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(halves, signMask), signMask)), value);
+    return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static inline __m256i Unorm16ToUnorm8_AVX2(__m256i values)
+{
+    return _mm256_srli_epi32(_mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(values, 8), values), _mm256_set1_epi32(32895)), 16);
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static inline __m256i FloatToUnorm8_AVX2(__m256 values)
+{
+    values = _mm256_min_ps(_mm256_max_ps(values, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(values, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static void ConvertRgba8_AVX2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m256i alpha = OpaqueAlpha_AVX2(opaque);
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const __m256i colors = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), FinishPixels_AVX2(colors, swap, alpha));
+    }
+
+    ConvertRgba8_Scalar(src + i * 4, dst + i * 4, width - i, swap, opaque);
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static void ConvertRgb10A2_AVX2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m256i alpha = OpaqueAlpha_AVX2(opaque);
+    const __m256i tenBitsMask = _mm256_set1_epi32(0x3ff);
+    const __m256i scale = _mm256_set1_epi32(1021);
+    const __m256i bias = _mm256_set1_epi32(2041);
+    const __m256i alphaScale = _mm256_set1_epi32(85);
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const __m256i colors = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        const __m256i c0 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(_mm256_and_si256(colors, tenBitsMask), scale), bias), 12);
+        const __m256i c1 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(_mm256_and_si256(_mm256_srli_epi32(colors, 10), tenBitsMask), scale), bias), 12);
+        const __m256i c2 = _mm256_srli_epi32(_mm256_add_epi32(_mm256_madd_epi16(_mm256_and_si256(_mm256_srli_epi32(colors, 20), tenBitsMask), scale), bias), 12);
+        const __m256i a = _mm256_madd_epi16(_mm256_srli_epi32(colors, 30), alphaScale);
+
+        const __m256i pixels = _mm256_or_si256(_mm256_or_si256(c0, _mm256_slli_epi32(c1, 8)), _mm256_or_si256(_mm256_slli_epi32(c2, 16), _mm256_slli_epi32(a, 24)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), FinishPixels_AVX2(pixels, swap, alpha));
+    }
+
+    ConvertRgb10A2_Scalar(src + i * 4, dst + i * 4, width - i, swap, opaque);
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static void ConvertRgba16Unorm_AVX2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m256i alpha = OpaqueAlpha_AVX2(opaque);
+    const __m256i zero = _mm256_setzero_si256();
+    // The packs work in each 128 bits lane, the pixels come out as 0 1 4 5 2 3 6 7.
+    const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 8));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 8 + 32));
+        const __m256i words0 = _mm256_packs_epi32(Unorm16ToUnorm8_AVX2(_mm256_unpacklo_epi16(first, zero)), Unorm16ToUnorm8_AVX2(_mm256_unpackhi_epi16(first, zero)));
+        const __m256i words1 = _mm256_packs_epi32(Unorm16ToUnorm8_AVX2(_mm256_unpacklo_epi16(second, zero)), Unorm16ToUnorm8_AVX2(_mm256_unpackhi_epi16(second, zero)));
+        const __m256i pixels = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(words0, words1), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), FinishPixels_AVX2(pixels, swap, alpha));
+    }
+
+    ConvertRgba16Unorm_Scalar(src + i * 8, dst + i * 4, width - i, swap, opaque);
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static void ConvertRgba16Float_AVX2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m256i alpha = OpaqueAlpha_AVX2(opaque);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 8));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 8 + 32));
+        const __m256i words0 = _mm256_packs_epi32(HalfToUnorm8_AVX2(_mm256_unpacklo_epi16(first, zero)), HalfToUnorm8_AVX2(_mm256_unpackhi_epi16(first, zero)));
+        const __m256i words1 = _mm256_packs_epi32(HalfToUnorm8_AVX2(_mm256_unpacklo_epi16(second, zero)), HalfToUnorm8_AVX2(_mm256_unpackhi_epi16(second, zero)));
+        const __m256i pixels = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(words0, words1), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), FinishPixels_AVX2(pixels, swap, alpha));
+    }
+
+    ConvertRgba16Float_Scalar(src + i * 8, dst + i * 4, width - i, swap, opaque);
+}
+
+INGAMEOVERLAY_TARGET_AVX2 static void ConvertRgba32Float_AVX2(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    const __m256i alpha = OpaqueAlpha_AVX2(opaque);
+    // Each load holds 2 pixels, one per 128 bits lane, they come out as 0 2 4 6 1 3 5 7.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const float* colors = reinterpret_cast<const float*>(src + i * 16);
+        const __m256i words0 = _mm256_packs_epi32(FloatToUnorm8_AVX2(_mm256_loadu_ps(colors))     , FloatToUnorm8_AVX2(_mm256_loadu_ps(colors + 8)));
+        const __m256i words1 = _mm256_packs_epi32(FloatToUnorm8_AVX2(_mm256_loadu_ps(colors + 16)), FloatToUnorm8_AVX2(_mm256_loadu_ps(colors + 24)));
+        const __m256i pixels = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(words0, words1), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), FinishPixels_AVX2(pixels, swap, alpha));
+    }
+
+    ConvertRgba32Float_Scalar(src + i * 16, dst + i * 4, width - i, swap, opaque);
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////
+// NEON
+
+#if defined(INGAMEOVERLAY_CONVERTER_NEON)
+
+// The channels are deinterleaved by the loads, the swap only picks which one is stored first.
+static inline void StorePixels_NEON(uint8_t* dst, uint8x8_t c0, uint8x8_t c1, uint8x8_t c2, uint8x8_t a, bool swap, bool opaque)
+{
+    uint8x8x4_t pixels;
+    pixels.val[0] = swap ? c2 : c0;
+    pixels.val[1] = c1;
+    pixels.val[2] = swap ? c0 : c2;
+    pixels.val[3] = opaque ? vdup_n_u8(255) : a;
+    vst4_u8(dst, pixels);
+}
+
+// Converts the low 10 bits of each lane.
+static inline uint16x4_t Unorm10ToUnorm8_NEON(uint32x4_t values)
+{
+    return vmovn_u32(vshrq_n_u32(vmlaq_n_u32(vdupq_n_u32(2041), vandq_u32(values, vdupq_n_u32(0x3ff)), 1021), 12));
+}
+
+static inline uint8x8_t Unorm16ToUnorm8_NEON(uint16x8_t values)
+{
+    const uint32x4_t bias = vdupq_n_u32(32895);
+    const uint16x4_t low = vshrn_n_u32(vmlaq_n_u32(bias, vmovl_u16(vget_low_u16(values)), 255), 16);
+    const uint16x4_t high = vshrn_n_u32(vmlaq_n_u32(bias, vmovl_u16(vget_high_u16(values)), 255), 16);
+    return vmovn_u16(vcombine_u16(low, high));
+}
+
+static inline uint32x4_t FloatToUnorm8_NEON(float32x4_t values)
+{
+    // vmaxnmq_f32 returns the number for the NaNs.
+    values = vminq_f32(vmaxnmq_f32(values, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    return vcvtq_u32_f32(vaddq_f32(vmulq_f32(values, vdupq_n_f32(255.0f)), vdupq_n_f32(0.5f)));
+}
+
+static inline uint32x4_t HalfToUnorm8x4_NEON(uint32x4_t halves)
+{
+    const float32x4_t magic = vreinterpretq_f32_u32(vdupq_n_u32((254 - 15) << 23));
+
+    float32x4_t value = vmulq_f32(vreinterpretq_f32_u32(vshlq_n_u32(vandq_u32(halves, vdupq_n_u32(0x7fff)), 13)), magic);
+    value = vminq_f32(value, vdupq_n_f32(1.0f));
+    const uint32x4_t positive = vceqq_u32(vandq_u32(halves, vdupq_n_u32(0x8000)), vdupq_n_u32(0));
+    value = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(value), positive));
+    return vcvtq_u32_f32(vaddq_f32(vmulq_f32(value, vdupq_n_f32(255.0f)), vdupq_n_f32(0.5f)));
+}
+
+static inline uint8x8_t HalfToUnorm8_NEON(uint16x8_t halves)
+{
+    const uint16x4_t low = vmovn_u32(HalfToUnorm8x4_NEON(vmovl_u16(vget_low_u16(halves))));
+    const uint16x4_t high = vmovn_u32(HalfToUnorm8x4_NEON(vmovl_u16(vget_high_u16(halves))));
+    return vmovn_u16(vcombine_u16(low, high));
+}
+
+static void ConvertRgba8_NEON(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    uint32_t i = 0;
+    for (; i + 16 <= width; i += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8(src + i * 4);
+        if (swap)
+        {
+            const uint8x16_t first = pixels.val[0];
+            pixels.val[0] = pixels.val[2];
+            pixels.val[2] = first;
+        }
+        if (opaque)
+            pixels.val[3] = vdupq_n_u8(255);
+
+        vst4q_u8(dst + i * 4, pixels);
+    }
+
+    ConvertRgba8_Scalar(src + i * 4, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgb10A2_NEON(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const uint32x4_t first = vld1q_u32(reinterpret_cast<const uint32_t*>(src + i * 4));
+        const uint32x4_t second = vld1q_u32(reinterpret_cast<const uint32_t*>(src + i * 4 + 16));
+        StorePixels_NEON(dst + i * 4,
+            vmovn_u16(vcombine_u16(Unorm10ToUnorm8_NEON(first)                  , Unorm10ToUnorm8_NEON(second))),
+            vmovn_u16(vcombine_u16(Unorm10ToUnorm8_NEON(vshrq_n_u32(first, 10)) , Unorm10ToUnorm8_NEON(vshrq_n_u32(second, 10)))),
+            vmovn_u16(vcombine_u16(Unorm10ToUnorm8_NEON(vshrq_n_u32(first, 20)) , Unorm10ToUnorm8_NEON(vshrq_n_u32(second, 20)))),
+            vmovn_u16(vcombine_u16(vmovn_u32(vmulq_n_u32(vshrq_n_u32(first, 30), 85)), vmovn_u32(vmulq_n_u32(vshrq_n_u32(second, 30), 85)))),
+            swap, opaque);
+    }
+
+    ConvertRgb10A2_Scalar(src + i * 4, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgba16Unorm_NEON(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const uint16x8x4_t colors = vld4q_u16(reinterpret_cast<const uint16_t*>(src + i * 8));
+        StorePixels_NEON(dst + i * 4,
+            Unorm16ToUnorm8_NEON(colors.val[0]),
+            Unorm16ToUnorm8_NEON(colors.val[1]),
+            Unorm16ToUnorm8_NEON(colors.val[2]),
+            Unorm16ToUnorm8_NEON(colors.val[3]),
+            swap, opaque);
+    }
+
+    ConvertRgba16Unorm_Scalar(src + i * 8, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgba16Float_NEON(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const uint16x8x4_t colors = vld4q_u16(reinterpret_cast<const uint16_t*>(src + i * 8));
+        StorePixels_NEON(dst + i * 4,
+            HalfToUnorm8_NEON(colors.val[0]),
+            HalfToUnorm8_NEON(colors.val[1]),
+            HalfToUnorm8_NEON(colors.val[2]),
+            HalfToUnorm8_NEON(colors.val[3]),
+            swap, opaque);
+    }
+
+    ConvertRgba16Float_Scalar(src + i * 8, dst + i * 4, width - i, swap, opaque);
+}
+
+static void ConvertRgba32Float_NEON(const uint8_t* src, uint8_t* dst, uint32_t width, bool swap, bool opaque)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= width; i += 8)
+    {
+        const float32x4x4_t first = vld4q_f32(reinterpret_cast<const float*>(src + i * 16));
+        const float32x4x4_t second = vld4q_f32(reinterpret_cast<const float*>(src + i * 16 + 64));
+
+        uint8x8_t channels[4];
+        for (int c = 0; c < 4; ++c)
+            channels[c] = vmovn_u16(vcombine_u16(vmovn_u32(FloatToUnorm8_NEON(first.val[c])), vmovn_u32(FloatToUnorm8_NEON(second.val[c]))));
+
+        StorePixels_NEON(dst + i * 4, channels[0], channels[1], channels[2], channels[3], swap, opaque);
+    }
+
+    ConvertRgba32Float_Scalar(src + i * 16, dst + i * 4, width - i, swap, opaque);
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////
+
+static bool IsConverterPathSupported(ScreenshotConverterPath_t path)
+{
+    switch (path)
+    {
+        case ScreenshotConverterPath_t::Scalar: return true;
+#if defined(INGAMEOVERLAY_CONVERTER_SSE2)
+        case ScreenshotConverterPath_t::SSE2  : return true;
+#endif
+#if defined(INGAMEOVERLAY_CONVERTER_AVX2)
+        case ScreenshotConverterPath_t::AVX2  :
+        {
+            static const bool supported = CpuSupportsAVX2();
+            return supported;
+        }
+#endif
+#if defined(INGAMEOVERLAY_CONVERTER_NEON)
+        case ScreenshotConverterPath_t::NEON  : return true;
+#endif
+        default: return false;
+    }
+}
+
+static RowConverter_t GetRowConverter(ConverterFamily_e family, ScreenshotConverterPath_t path)
+{
+    switch (path)
+    {
+        case ScreenshotConverterPath_t::Scalar:
+            switch (family)
+            {
+                case ConverterFamily_e::Rgba8      : return ConvertRgba8_Scalar;
+                case ConverterFamily_e::Rgb8       : return ConvertRgb8_Scalar;
+                case ConverterFamily_e::Rgb10A2    : return ConvertRgb10A2_Scalar;
+                case ConverterFamily_e::R5G6B5     : return ConvertR5G6B5_Scalar;
+                case ConverterFamily_e::R5G5B5A1   : return ConvertR5G5B5A1_Scalar;
+                case ConverterFamily_e::Rgba16Unorm: return ConvertRgba16Unorm_Scalar;
+                case ConverterFamily_e::Rgba16Float: return ConvertRgba16Float_Scalar;
+                case ConverterFamily_e::Rgba32Float: return ConvertRgba32Float_Scalar;
+                default:                             return nullptr;
+            }
+
+#if defined(INGAMEOVERLAY_CONVERTER_SSE2)
+        case ScreenshotConverterPath_t::SSE2:
+            switch (family)
+            {
+                case ConverterFamily_e::Rgba8      : return ConvertRgba8_SSE2;
+                case ConverterFamily_e::Rgb10A2    : return ConvertRgb10A2_SSE2;
+                case ConverterFamily_e::R5G6B5     : return ConvertR5G6B5_SSE2;
+                case ConverterFamily_e::R5G5B5A1   : return ConvertR5G5B5A1_SSE2;
+                case ConverterFamily_e::Rgba16Unorm: return ConvertRgba16Unorm_SSE2;
+                case ConverterFamily_e::Rgba16Float: return ConvertRgba16Float_SSE2;
+                case ConverterFamily_e::Rgba32Float: return ConvertRgba32Float_SSE2;
+                default:                             return nullptr;
+            }
+#endif
+
+#if defined(INGAMEOVERLAY_CONVERTER_AVX2)
+        case ScreenshotConverterPath_t::AVX2:
+            switch (family)
+            {
+                case ConverterFamily_e::Rgba8      : return ConvertRgba8_AVX2;
+                case ConverterFamily_e::Rgb10A2    : return ConvertRgb10A2_AVX2;
+                case ConverterFamily_e::Rgba16Unorm: return ConvertRgba16Unorm_AVX2;
+                case ConverterFamily_e::Rgba16Float: return ConvertRgba16Float_AVX2;
+                case ConverterFamily_e::Rgba32Float: return ConvertRgba32Float_AVX2;
+                default:                             return nullptr;
+            }
+#endif
+
+#if defined(INGAMEOVERLAY_CONVERTER_NEON)
+        case ScreenshotConverterPath_t::NEON:
+            switch (family)
+            {
+                case ConverterFamily_e::Rgba8      : return ConvertRgba8_NEON;
+                case ConverterFamily_e::Rgb10A2    : return ConvertRgb10A2_NEON;
+                case ConverterFamily_e::Rgba16Unorm: return ConvertRgba16Unorm_NEON;
+                case ConverterFamily_e::Rgba16Float: return ConvertRgba16Float_NEON;
+                case ConverterFamily_e::Rgba32Float: return ConvertRgba32Float_NEON;
+                default:                             return nullptr;
+            }
+#endif
+
+        default: return nullptr;
+    }
+}
+
+static ScreenshotConverterPath_t ResolveConverterPath(ConverterFamily_e family, ScreenshotConverterPath_t path)
+{
+    if (path == ScreenshotConverterPath_t::Auto)
+    {
+        path = IsConverterPathSupported(ScreenshotConverterPath_t::AVX2) ? ScreenshotConverterPath_t::AVX2
+            : IsConverterPathSupported(ScreenshotConverterPath_t::SSE2) ? ScreenshotConverterPath_t::SSE2
+            : IsConverterPathSupported(ScreenshotConverterPath_t::NEON) ? ScreenshotConverterPath_t::NEON
+            : ScreenshotConverterPath_t::Scalar;
+    }
+
+    while (path != ScreenshotConverterPath_t::Scalar && (!IsConverterPathSupported(path) || GetRowConverter(family, path) == nullptr))
+        path = path == ScreenshotConverterPath_t::AVX2 ? ScreenshotConverterPath_t::SSE2 : ScreenshotConverterPath_t::Scalar;
+
+    return path;
+}
+
+uint32_t GetScreenshotFormatPixelSize(ScreenshotDataFormat_t format)
+{
+    switch (format)
+    {
+        case ScreenshotDataFormat_t::R5G6B5            :
+        case ScreenshotDataFormat_t::X1R5G5B5          :
+        case ScreenshotDataFormat_t::A1R5G5B5          :
+        case ScreenshotDataFormat_t::B5G6R5            :
+        case ScreenshotDataFormat_t::B5G5R5A1          : return 2;
+
+        case ScreenshotDataFormat_t::R8G8B8            : return 3;
+
+        case ScreenshotDataFormat_t::X8R8G8B8          :
+        case ScreenshotDataFormat_t::A8R8G8B8          :
+        case ScreenshotDataFormat_t::B8G8R8A8          :
+        case ScreenshotDataFormat_t::B8G8R8X8          :
+        case ScreenshotDataFormat_t::R8G8B8A8          :
+        case ScreenshotDataFormat_t::A2R10G10B10       :
+        case ScreenshotDataFormat_t::A2B10G10R10       :
+        case ScreenshotDataFormat_t::R10G10B10A2       : return 4;
+
+        case ScreenshotDataFormat_t::R16G16B16A16_FLOAT:
+        case ScreenshotDataFormat_t::R16G16B16A16_UNORM: return 8;
+
+        case ScreenshotDataFormat_t::R32G32B32A32_FLOAT: return 16;
+
+        default: return 0;
+    }
+}
+
+ScreenshotConverterPath_t GetScreenshotConverterPath(ScreenshotDataFormat_t format, ScreenshotConverterPath_t path)
+{
+    return ResolveConverterPath(GetConverterLayout(format).Family, path);
+}
+
+bool ConvertScreenshotData(ScreenshotDataFormat_t format, const void* data, uint32_t width, uint32_t height, uint32_t pitch,
+    ScreenshotOutputFormat_t outputFormat, void* output, uint32_t outputPitch,
+    ScreenshotConverterPath_t path)
+{
+    const auto layout = GetConverterLayout(format);
+    if (layout.Family == ConverterFamily_e::Unknown || data == nullptr || output == nullptr)
+        return false;
+
+    const auto convert = GetRowConverter(layout.Family, ResolveConverterPath(layout.Family, path));
+    const bool swap = layout.SourceBgr != (outputFormat == ScreenshotOutputFormat_t::B8G8R8A8);
+    const size_t sourcePitch = pitch == 0 ? size_t(width) * GetScreenshotFormatPixelSize(format) : pitch;
+    const size_t destinationPitch = outputPitch == 0 ? size_t(width) * 4 : outputPitch;
+
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(data);
+    uint8_t* dst = reinterpret_cast<uint8_t*>(output);
+    for (uint32_t row = 0; row < height; ++row)
+        convert(src + row * sourcePitch, dst + row * destinationPitch, width, swap, layout.Opaque);
+
+    return true;
+}
+
+bool ConvertScreenshot(ScreenshotCallbackParameter_t const* screenshot, ScreenshotOutputFormat_t outputFormat, void* output, uint32_t outputPitch)
+{
+    if (screenshot == nullptr)
+        return false;
+
+    return ConvertScreenshotData(screenshot->Format, screenshot->Data, screenshot->Width, screenshot->Height, screenshot->Pitch, outputFormat, output, outputPitch);
+}
+
+}
@@ -1,369 +1,928 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#include "OpenGLHook.h"
-#include "WindowsHook.h"
-
-#include <imgui.h>
-#include <imgui_internal.h>
-#include <backends/imgui_impl_opengl3.h>
-
-#include <glad/gl.h>
-
-namespace InGameOverlay {
-
-#define TRY_HOOK_FUNCTION_OR_FAIL(NAME) do { if (!HookFunc(std::make_pair<void**, void*>(&(void*&)_##NAME, (void*)&OpenGLHook_t::_My##NAME))) { \
-    INGAMEOVERLAY_ERROR("Failed to hook {}", #NAME);\
-    UnhookAll();\
-    return false;\
-} } while(0)
-
-OpenGLHook_t* OpenGLHook_t::_Instance = nullptr;
-
-bool OpenGLHook_t::StartHook(std::function<void()> keyCombinationCallback, ToggleKey toggleKeys[], int toggleKeysCount, /*ImFontAtlas* */ void* imguiFontAtlas)
-{
-    if (!_Hooked)
-    {
-        if (_WGLSwapBuffers == nullptr)
-        {
-            INGAMEOVERLAY_WARN("Failed to hook OpenGL: Rendering functions missing.");
-            return false;
-        }
-
-        if (!WindowsHook_t::Inst()->StartHook(keyCombinationCallback, toggleKeys, toggleKeysCount))
-            return false;
-
-        _WindowsHooked = true;
-
-        BeginHook();
-        TRY_HOOK_FUNCTION_OR_FAIL(WGLSwapBuffers);
-        EndHook();
-
-        INGAMEOVERLAY_INFO("Hooked OpenGL");
-        _Hooked = true;
-        _ImGuiFontAtlas = imguiFontAtlas;
-    }
-    return true;
-}
-
-void OpenGLHook_t::HideAppInputs(bool hide)
-{
-    if (_Initialized)
-    {
-        WindowsHook_t::Inst()->HideAppInputs(hide);
-    }
-}
-
-void OpenGLHook_t::HideOverlayInputs(bool hide)
-{
-    if (_Initialized)
-    {
-        WindowsHook_t::Inst()->HideOverlayInputs(hide);
-    }
-}
-
-bool OpenGLHook_t::IsStarted()
-{
-    return _Hooked;
-}
-
-void OpenGLHook_t::_ResetRenderState(OverlayHookState state)
-{
-    if (_HookState == state)
-        return;
-
-    OverlayHookReady(state);
-
-    _HookState = state;
-
-    switch (state)
-    {
-        case OverlayHookState::Reset:
-            break;
-
-        case OverlayHookState::Removing:
-            ImGui_ImplOpenGL3_Shutdown();
-            WindowsHook_t::Inst()->ResetRenderState(state);
-            //ImGui::DestroyContext();
-
-            _ImageResources.clear();
-
-            _LastWindow = nullptr;
-            _Initialized = false;
-    }
-}
-
-// Try to make this function and overlay's proc as short as possible or it might affect game's fps.
-void OpenGLHook_t::_PrepareForOverlay(HDC hDC)
-{
-    HWND hWnd = WindowFromDC(hDC);
-
-    if (hWnd != _LastWindow)
-        _ResetRenderState(OverlayHookState::Removing);
-
-    if (!_Initialized)
-    {
-        if (ImGui::GetCurrentContext() == nullptr)
-            ImGui::CreateContext(reinterpret_cast<ImFontAtlas*>(_ImGuiFontAtlas));
-
-        ImGui_ImplOpenGL3_Init();
-
-        _LastWindow = hWnd;
-
-        WindowsHook_t::Inst()->SetInitialWindowSize(hWnd);
-
-        _Initialized = true;
-        _ResetRenderState(OverlayHookState::Ready);
-    }
-
-    if (ImGui_ImplOpenGL3_NewFrame() && WindowsHook_t::Inst()->PrepareForOverlay(hWnd))
-    {
-        auto screenshotType = _ScreenshotType();
-        if (screenshotType == ScreenshotType_t::BeforeOverlay)
-            _HandleScreenshot();
-
-        if (_ImGuiFontAtlas != nullptr)
-        {
-            const bool has_textures = (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasTextures) != 0;
-            ImFontAtlasUpdateNewFrame(reinterpret_cast<ImFontAtlas*>(_ImGuiFontAtlas), ImGui::GetFrameCount(), has_textures);
-        }
-
-        ++_CurrentFrame;
-        ImGui::NewFrame();
-
-        OverlayProc();
-
-        _LoadResources();
-        _ReleaseResources();
-
-        ImGui::Render();
-
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-        if (screenshotType == ScreenshotType_t::AfterOverlay)
-            _HandleScreenshot();
-    }
-}
-
-void OpenGLHook_t::_LoadResources()
-{
-    if (_ImageResourcesToLoad.empty())
-        return;
-
-    // Save old texture id
-    GLint oldTex;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &oldTex);
-
-    struct ValidTexture_t
-    {
-        std::shared_ptr<RendererTexture_t> Resource;
-        const void* Data;
-        uint32_t Width;
-        uint32_t Height;
-    };
-
-    std::vector<ValidTexture_t> validResources;
-
-    const auto loadParameterCount = _ImageResourcesToLoad.size() > _BatchSize ? _BatchSize : _ImageResourcesToLoad.size();
-
-    for (size_t i = 0; i < loadParameterCount; ++i)
-    {
-        auto& param = _ImageResourcesToLoad[i];
-        auto r = param.Resource.lock();
-        if (!r) continue;
-
-        validResources.push_back(ValidTexture_t{
-            r,
-            param.Data,
-            param.Width,
-            param.Height
-        });
-    }
-
-    if (!validResources.empty())
-    {
-        for (size_t i = 0; i < validResources.size(); ++i)
-        {
-            auto& tex = validResources[i];
-
-            glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(tex.Resource->ImGuiTextureId));
-
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            // Upload pixels into texture
-            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex.Width, tex.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, tex.Data);
-
-            tex.Resource->LoadStatus = RendererTextureStatus_e::Loaded;
-        }
-    }
-
-    glBindTexture(GL_TEXTURE_2D, oldTex);
-
-    _ImageResourcesToLoad.erase(_ImageResourcesToLoad.begin(),
-        _ImageResourcesToLoad.begin() + loadParameterCount);
-}
-
-void OpenGLHook_t::_ReleaseResources()
-{
-    _ImageResourcesToRelease.clear();
-}
-
-void OpenGLHook_t::_HandleScreenshot()
-{
-    int viewport[8];
-    int width, height;
-    glGetIntegerv(GL_VIEWPORT, viewport); // viewport[2] = width, viewport[3] = height
-    width = viewport[2];
-    height = viewport[3];
-
-    int bytesPerPixel = 4;
-
-    std::vector<uint8_t> buffer(width * height * bytesPerPixel);
-
-    GLboolean isDoubleBuffered = GL_FALSE;
-    glGetBooleanv(GL_DOUBLEBUFFER, &isDoubleBuffered);
-
-    glReadBuffer(isDoubleBuffered ? GL_BACK : GL_FRONT);
-    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffer.data());
-
-    std::vector<uint8_t> lineBuffer(width * bytesPerPixel);
-
-    for (int i = 0; i < (height / 2); ++i)
-    {
-        uint8_t* topLine = buffer.data() + i * width * bytesPerPixel;
-        uint8_t* bottomLine = buffer.data() + (height - i - 1) * width * bytesPerPixel;
-
-        memcpy(lineBuffer.data(), topLine, width * bytesPerPixel);
-        memcpy(topLine, bottomLine, width * bytesPerPixel);
-        memcpy(bottomLine, lineBuffer.data(), width * bytesPerPixel);
-    }
-
-    ScreenshotCallbackParameter_t screenshot;
-    screenshot.Width = width;
-    screenshot.Height = height;
-    screenshot.Pitch = bytesPerPixel * width;
-    screenshot.Data = reinterpret_cast<void*>(buffer.data());
-    screenshot.Format = InGameOverlay::ScreenshotDataFormat_t::R8G8B8A8;
-
-    _SendScreenshot(&screenshot);
-}
-
-BOOL WINAPI OpenGLHook_t::_MyWGLSwapBuffers(HDC hDC)
-{
-    auto inst = OpenGLHook_t::Inst();
-    inst->_PrepareForOverlay(hDC);
-    return inst->_WGLSwapBuffers(hDC);
-}
-
-OpenGLHook_t::OpenGLHook_t():
-    _Hooked(false),
-    _WindowsHooked(false),
-    _Initialized(false),
-    _HookState(OverlayHookState::Removing),
-    _LastWindow(nullptr),
-    _ImGuiFontAtlas(nullptr),
-    _WGLSwapBuffers(nullptr)
-{
-}
-
-OpenGLHook_t::~OpenGLHook_t()
-{
-    INGAMEOVERLAY_INFO("OpenGL Hook removed");
-
-    if (_WindowsHooked)
-        delete WindowsHook_t::Inst();
-
-    _ResetRenderState(OverlayHookState::Removing);
-
-    _Instance->UnhookAll();
-    _Instance = nullptr;
-}
-
-OpenGLHook_t* OpenGLHook_t::Inst()
-{
-    if (_Instance == nullptr)
-        _Instance = new OpenGLHook_t;
-
-    return _Instance;
-}
-
-const char* OpenGLHook_t::GetLibraryName() const
-{
-    return LibraryName.c_str();
-}
-
-RendererHookType_t OpenGLHook_t::GetRendererHookType() const
-{
-    return RendererHookType_t::OpenGL;
-}
-
-void OpenGLHook_t::LoadFunctions(WGLSwapBuffers_t pfnwglSwapBuffers)
-{
-    _WGLSwapBuffers = pfnwglSwapBuffers;
-}
-
-std::weak_ptr<RendererTexture_t> OpenGLHook_t::AllocImageResource()
-{
-    GLuint texture = 0;
-    glGenTextures(1, &texture);
-    if (glGetError() != GL_NO_ERROR)
-        return std::weak_ptr<RendererTexture_t>{};
-
-    auto ptr = std::shared_ptr<RendererTexture_t>(new RendererTexture_t(), [](RendererTexture_t* handle)
-    {
-        if (handle != nullptr)
-        {
-            auto resource = static_cast<GLuint>(handle->ImGuiTextureId);
-            glDeleteTextures(1, &resource);
-            delete handle;
-        }
-    });
-    ptr->ImGuiTextureId = static_cast<uint64_t>(texture);
-
-    _ImageResources.emplace(ptr);
-
-    return ptr;
-}
-
-void OpenGLHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParameter)
-{
-    _ImageResourcesToLoad.emplace_back(loadParameter);
-}
-
-void OpenGLHook_t::ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource)
-{
-    auto ptr = resource.lock();
-    if (ptr)
-    {
-        auto it = _ImageResources.find(ptr);
-        if (it != _ImageResources.end())
-        {
-            _ImageResources.erase(it);
-            _ImageResourcesToRelease.emplace_back(RendererTextureReleaseParameter_t
-            {
-                std::move(ptr),
-                _CurrentFrame
-            });
-        }
-    }
-}
-
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpenGLHook.h"
+#include "WindowsHook.h"
+#include "../RendererFormatInternal.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <backends/imgui_impl_opengl3.h>
+
+#include <glad/gl.h>
+
+namespace InGameOverlay {
+
+#define TRY_HOOK_FUNCTION_OR_FAIL(NAME) do { if (!HookFunc(std::make_pair<void**, void*>(&(void*&)_##NAME, (void*)&OpenGLHook_t::_My##NAME))) { \
+    INGAMEOVERLAY_ERROR("Failed to hook {}", #NAME);\
+    UnhookAll();\
+    return false;\
+} } while(0)
+
+OpenGLHook_t* OpenGLHook_t::_Instance = nullptr;
+
+static GLenum ResourceFormatToGLFormat(ResourceFormat_t format)
+{
+    switch (format)
+    {
+        case ResourceFormat_t::BC1       : return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case ResourceFormat_t::BC3       : return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case ResourceFormat_t::BC7       : return GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
+        case ResourceFormat_t::ETC2_RGB8 : return GL_COMPRESSED_RGB8_ETC2;
+        case ResourceFormat_t::ETC2_RGBA8: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case ResourceFormat_t::R8G8B8A8  :
+        default                          : return GL_RGBA;
+    }
+}
+
+// Loads the bound texture, pixels is an offset in the pixel unpack buffer if one is bound.
+static void TexImage2D(ResourceFormat_t format, uint32_t width, uint32_t height, const void* pixels)
+{
+    switch (format)
+    {
+        case ResourceFormat_t::R8G8B8A8:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+            break;
+
+        case ResourceFormat_t::B8G8R8A8:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+            break;
+
+        case ResourceFormat_t::R5G6B5:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pixels);
+            break;
+
+        case ResourceFormat_t::A8:
+        {
+            // Sampled as a white image with the red channel as alpha.
+            const GLint swizzle[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+        }
+        break;
+
+        case ResourceFormat_t::R16G16B16A16_FLOAT:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, pixels);
+            break;
+
+        default:
+            glCompressedTexImage2D(GL_TEXTURE_2D, 0, ResourceFormatToGLFormat(format), width, height, 0, static_cast<GLsizei>(GetResourceFormatDataSize(format, width, height)), pixels);
+    }
+}
+
+static bool GenerateMipmapSupported()
+{
+    return GLAD_GL_VERSION_3_0 || GLAD_GL_ARB_framebuffer_object;
+}
+
+bool OpenGLHook_t::StartHook(std::function<void()> keyCombinationCallback, ToggleKey toggleKeys[], int toggleKeysCount, /*ImFontAtlas* */ void* imguiFontAtlas)
+{
+    if (!_Hooked)
+    {
+        if (_WGLSwapBuffers == nullptr)
+        {
+            INGAMEOVERLAY_WARN("Failed to hook OpenGL: Rendering functions missing.");
+            return false;
+        }
+
+        if (!WindowsHook_t::Inst()->StartHook(keyCombinationCallback, toggleKeys, toggleKeysCount))
+            return false;
+
+        _WindowsHooked = true;
+
+        BeginHook();
+        TRY_HOOK_FUNCTION_OR_FAIL(WGLSwapBuffers);
+        EndHook();
+
+        INGAMEOVERLAY_INFO("Hooked OpenGL");
+        _Hooked = true;
+        _ImGuiFontAtlas = imguiFontAtlas;
+    }
+    return true;
+}
+
+void OpenGLHook_t::HideAppInputs(bool hide)
+{
+    if (_Initialized)
+    {
+        WindowsHook_t::Inst()->HideAppInputs(hide);
+    }
+}
+
+void OpenGLHook_t::HideOverlayInputs(bool hide)
+{
+    if (_Initialized)
+    {
+        WindowsHook_t::Inst()->HideOverlayInputs(hide);
+    }
+}
+
+bool OpenGLHook_t::IsStarted()
+{
+    return _Hooked;
+}
+
+void OpenGLHook_t::_ResetRenderState(OverlayHookState state)
+{
+    if (_HookState == state)
+        return;
+
+    OverlayHookReady(state);
+
+    _HookState = state;
+
+    switch (state)
+    {
+        case OverlayHookState::Reset:
+            break;
+
+        case OverlayHookState::Removing:
+            ImGui_ImplOpenGL3_Shutdown();
+            WindowsHook_t::Inst()->ResetRenderState(state);
+            //ImGui::DestroyContext();
+
+            _DestroyUploadSlots();
+            _DestroyFrameFences();
+            _DestroyScreenshotSlots();
+            _ClearTextures();
+            _ClearRetiredTextures();
+
+            _LastWindow = nullptr;
+            _Initialized = false;
+    }
+}
+
+// Try to make this function and overlay's proc as short as possible or it might affect game's fps.
+void OpenGLHook_t::_PrepareForOverlay(HDC hDC)
+{
+    HWND hWnd = WindowFromDC(hDC);
+
+    if (hWnd != _LastWindow)
+        _ResetRenderState(OverlayHookState::Removing);
+
+    if (!_Initialized)
+    {
+        if (ImGui::GetCurrentContext() == nullptr)
+            ImGui::CreateContext(reinterpret_cast<ImFontAtlas*>(_ImGuiFontAtlas));
+
+        ImGui_ImplOpenGL3_Init();
+
+        _LastWindow = hWnd;
+
+        WindowsHook_t::Inst()->SetInitialWindowSize(hWnd);
+
+        _Initialized = true;
+        _ResetRenderState(OverlayHookState::Ready);
+    }
+
+    if (ImGui_ImplOpenGL3_NewFrame() && WindowsHook_t::Inst()->PrepareForOverlay(hWnd))
+    {
+        _PollScreenshots();
+
+        auto screenshotType = _ScreenshotType();
+        if (screenshotType == ScreenshotType_t::BeforeOverlay)
+            _HandleScreenshot();
+
+        if (_ImGuiFontAtlas != nullptr)
+        {
+            const bool has_textures = (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasTextures) != 0;
+            ImFontAtlasUpdateNewFrame(reinterpret_cast<ImFontAtlas*>(_ImGuiFontAtlas), ImGui::GetFrameCount(), has_textures);
+        }
+
+        ++_CurrentFrame;
+        ImGui::NewFrame();
+
+        _ProcessResourceCommands();
+        OverlayProc();
+        _ProcessPreloads();
+
+        _LoadResources();
+        _ReleaseResources();
+
+        ImGui::Render();
+
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+        if (GLAD_GL_VERSION_3_2 || GLAD_GL_ARB_sync)
+            _FrameFences.emplace_back(FrameFence_t{ _CurrentFrame, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) });
+        else
+            // The driver keeps the deleted textures alive while the submitted commands use them.
+            _SetCompletedFrame(_CurrentFrame);
+
+        if (screenshotType == ScreenshotType_t::AfterOverlay)
+            _HandleScreenshot();
+    }
+}
+
+bool OpenGLHook_t::_CreateUploadSlots()
+{
+    const size_t slotSize = (_UploadBufferSize / UploadSlotCount) & ~size_t(15);
+
+    if (_UploadSlots[0].Buffer != 0)
+    {
+        if (_UploadSlotSize == slotSize)
+            return true;
+
+        // Recreate the buffers with the new size once they are all idle.
+        for (auto& slot : _UploadSlots)
+        {
+            if (slot.Fence != nullptr)
+                return true;
+        }
+
+        _DestroyUploadSlots();
+    }
+
+    if ((!GLAD_GL_VERSION_3_2 && !GLAD_GL_ARB_sync) || slotSize == 0)
+    {
+        _UploadMode = UploadMode_t::Direct;
+        return false;
+    }
+
+    _UploadMode = GLAD_GL_ARB_buffer_storage && _PersistentMappingSupported
+        ? UploadMode_t::Persistent
+        : UploadMode_t::Unsynchronized;
+
+    GLint oldUnpackBuffer;
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &oldUnpackBuffer);
+
+    for (auto& slot : _UploadSlots)
+    {
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        slot.Buffer = buffer;
+
+        if (_UploadMode == UploadMode_t::Persistent)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, slotSize, nullptr, flags);
+            slot.MappedData = reinterpret_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, slotSize, flags));
+        }
+        else
+        {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, slotSize, nullptr, GL_STREAM_DRAW);
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, oldUnpackBuffer);
+
+    _UploadSlotSize = slotSize;
+    _NextUploadSlot = 0;
+
+    for (auto& slot : _UploadSlots)
+    {
+        if (_UploadMode == UploadMode_t::Persistent && slot.MappedData == nullptr)
+        {
+            // Try again with mapping the buffers on each upload.
+            _DestroyUploadSlots();
+            _PersistentMappingSupported = false;
+            return _CreateUploadSlots();
+        }
+    }
+
+    return true;
+}
+
+void OpenGLHook_t::_DestroyUploadSlots()
+{
+    for (auto& slot : _UploadSlots)
+    {
+        if (slot.Fence != nullptr)
+            glDeleteSync(slot.Fence);
+
+        if (slot.Buffer != 0)
+        {
+            GLuint buffer = slot.Buffer;
+            // Deleting a buffer unmaps it.
+            glDeleteBuffers(1, &buffer);
+        }
+
+        slot = UploadSlot_t{};
+    }
+    _UploadSlotSize = 0;
+}
+
+void OpenGLHook_t::_PollUploadSlots()
+{
+    for (auto& slot : _UploadSlots)
+    {
+        if (slot.Fence == nullptr)
+            continue;
+
+        const GLenum result = glClientWaitSync(slot.Fence, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            continue;
+
+        for (auto& texture : slot.Textures)
+        {
+            auto textureSlot = GetTextureSlot(texture->Handle);
+            if (textureSlot != nullptr && textureSlot->LoadStatus == RendererTextureStatus_e::Loading)
+                _SetTextureLoadStatus(texture->Handle, RendererTextureStatus_e::Loaded);
+        }
+
+        glDeleteSync(slot.Fence);
+        slot.Fence = nullptr;
+        slot.Textures.clear();
+    }
+}
+
+void OpenGLHook_t::_LoadResources()
+{
+    if (_UploadMode != UploadMode_t::Direct)
+        _PollUploadSlots();
+
+    if (_ImageResourcesToLoad.empty() && _ImageResourcesToUpdate.empty())
+        return;
+
+    // Save old texture id
+    GLint oldTex;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &oldTex);
+
+    // The rows of the 1 and 2 bytes formats are not 4 bytes aligned.
+    GLint oldUnpackAlignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &oldUnpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // The application might have a pixel buffer bound, the client memory pointers would be read as offsets.
+    GLint oldUnpackBuffer;
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &oldUnpackBuffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    struct ValidTexture_t
+    {
+        std::shared_ptr<RendererTexture_t> Resource;
+        const void* Data;
+        uint32_t Width;
+        uint32_t Height;
+        ResourceFormat_t Format;
+        // Offset in the upload slot or -1 to upload from the client memory.
+        GLintptr Offset;
+        bool GenerateMipmaps;
+    };
+
+    std::vector<ValidTexture_t> validResources;
+
+    UploadSlot_t* slot = nullptr;
+    if (!_ImageResourcesToLoad.empty() && _CreateUploadSlots() && _UploadSlots[_NextUploadSlot].Fence == nullptr)
+        slot = &_UploadSlots[_NextUploadSlot];
+
+    const auto loadParameterCount = _BeginLoadBatch(_ImageResourcesToLoad);
+    size_t processedCount = 0;
+    size_t slotUsedSize = 0;
+    uint64_t loadedBytes = 0;
+
+    for (; processedCount < loadParameterCount; ++processedCount)
+    {
+        auto& param = _ImageResourcesToLoad[processedCount];
+        auto r = _GetTexture(param.Resource);
+        if (!r) continue;
+
+        const size_t size = GetResourceFormatDataSize(param.Format, param.Width, param.Height);
+        GLintptr offset = -1;
+
+        if (_UploadMode != UploadMode_t::Direct && size <= _UploadSlotSize)
+        {
+            // All the slots are in flight or the slot is full, keep the remaining resources for the next frame.
+            if (slot == nullptr || slotUsedSize + size > _UploadSlotSize)
+                break;
+
+            offset = GLintptr(slotUsedSize);
+            slotUsedSize = (slotUsedSize + size + 15) & ~size_t(15);
+        }
+
+        loadedBytes += size;
+        validResources.push_back(ValidTexture_t{
+            r,
+            param.Data,
+            param.Width,
+            param.Height,
+            param.Format,
+            offset,
+            param.GenerateMipmaps && GenerateMipmapSupported()
+        });
+    }
+
+    uint8_t* slotData = nullptr;
+    if (slotUsedSize != 0)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->Buffer);
+
+        // The slot fence is signaled, the buffer is not read anymore.
+        slotData = _UploadMode == UploadMode_t::Persistent
+            ? slot->MappedData
+            : reinterpret_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, slotUsedSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+
+        for (auto& tex : validResources)
+        {
+            if (tex.Offset == -1)
+                continue;
+
+            if (slotData != nullptr)
+                memcpy(slotData + tex.Offset, tex.Data, GetResourceFormatDataSize(tex.Format, tex.Width, tex.Height));
+            else
+                tex.Offset = -1;
+        }
+
+        if (slotData != nullptr && _UploadMode == UploadMode_t::Unsynchronized)
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+
+    if (!validResources.empty())
+    {
+        for (size_t i = 0; i < validResources.size(); ++i)
+        {
+            auto& tex = validResources[i];
+
+            glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(tex.Resource->ImGuiTextureId));
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, tex.GenerateMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            tex.Resource->MipLevels = tex.GenerateMipmaps ? GetMipLevelCount(tex.Width, tex.Height) : 1;
+
+            // Upload pixels into texture
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            if (tex.Offset != -1)
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->Buffer);
+                TexImage2D(tex.Format, tex.Width, tex.Height, reinterpret_cast<const void*>(tex.Offset));
+                if (tex.GenerateMipmaps)
+                    glGenerateMipmap(GL_TEXTURE_2D);
+                // Loaded once the slot fence is signaled.
+                slot->Textures.emplace_back(tex.Resource);
+            }
+            else
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                TexImage2D(tex.Format, tex.Width, tex.Height, tex.Data);
+                if (tex.GenerateMipmaps)
+                    glGenerateMipmap(GL_TEXTURE_2D);
+                _SetTextureLoadStatus(tex.Resource->Handle, RendererTextureStatus_e::Loaded);
+            }
+        }
+    }
+
+    if (slot != nullptr && !slot->Textures.empty())
+    {
+        slot->Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _NextUploadSlot = (_NextUploadSlot + 1) % UploadSlotCount;
+    }
+
+    _EndLoadBatch(loadedBytes);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    for (auto& param : _ImageResourcesToUpdate)
+    {
+        auto textureSlot = GetTextureSlot(param.Resource);
+        if (textureSlot == nullptr || textureSlot->LoadStatus != RendererTextureStatus_e::Loaded) continue;
+        auto r = _GetTexture(param.Resource);
+
+        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(r->ImGuiTextureId));
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, param.X, param.Y, param.Width, param.Height, GL_RGBA, GL_UNSIGNED_BYTE, param.Data.data());
+        if (r->MipLevels > 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    _ImageResourcesToUpdate.clear();
+
+    glBindTexture(GL_TEXTURE_2D, oldTex);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, oldUnpackBuffer);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, oldUnpackAlignment);
+
+    _ImageResourcesToLoad.erase(_ImageResourcesToLoad.begin(),
+        _ImageResourcesToLoad.begin() + processedCount);
+}
+
+void OpenGLHook_t::_DestroyFrameFences()
+{
+    for (auto& frameFence : _FrameFences)
+        glDeleteSync(frameFence.Fence);
+
+    _FrameFences.clear();
+}
+
+void OpenGLHook_t::_ReleaseResources()
+{
+    while (!_FrameFences.empty())
+    {
+        auto& frameFence = _FrameFences.front();
+        if (glClientWaitSync(frameFence.Fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            break;
+
+        _SetCompletedFrame(frameFence.Frame);
+        glDeleteSync(frameFence.Fence);
+        _FrameFences.pop_front();
+    }
+
+    _ReleaseRetiredTextures();
+}
+
+void OpenGLHook_t::_HandleScreenshot()
+{
+    int viewport[8];
+    int width, height;
+    glGetIntegerv(GL_VIEWPORT, viewport); // viewport[2] = width, viewport[3] = height
+    width = viewport[2];
+    height = viewport[3];
+
+    const auto region = _ScreenshotRegion(std::max(width, 0), std::max(height, 0));
+    if (region.Width == 0 || region.Height == 0)
+    {
+        _SendScreenshot(nullptr);
+        return;
+    }
+
+    // The rectangle is from the top left corner, OpenGL reads from the bottom left one.
+    const int x = region.X;
+    const int y = height - int(region.Y + region.Height);
+    width = region.Width;
+    height = region.Height;
+    if (_ReadScreenshotAsync(x, y, width, height, region.TargetWidth, region.TargetHeight))
+        return;
+
+    int bytesPerPixel = 4;
+
+    std::vector<uint8_t> buffer(width * height * bytesPerPixel);
+
+    GLboolean isDoubleBuffered = GL_FALSE;
+    glGetBooleanv(GL_DOUBLEBUFFER, &isDoubleBuffered);
+
+    glReadBuffer(isDoubleBuffered ? GL_BACK : GL_FRONT);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffer.data());
+
+    std::vector<uint8_t> lineBuffer(width * bytesPerPixel);
+
+    for (int i = 0; i < (height / 2); ++i)
+    {
+        uint8_t* topLine = buffer.data() + i * width * bytesPerPixel;
+        uint8_t* bottomLine = buffer.data() + (height - i - 1) * width * bytesPerPixel;
+
+        memcpy(lineBuffer.data(), topLine, width * bytesPerPixel);
+        memcpy(topLine, bottomLine, width * bytesPerPixel);
+        memcpy(bottomLine, lineBuffer.data(), width * bytesPerPixel);
+    }
+
+    ScreenshotCallbackParameter_t screenshot;
+    screenshot.Width = width;
+    screenshot.Height = height;
+    screenshot.Pitch = bytesPerPixel * width;
+    screenshot.Data = reinterpret_cast<void*>(buffer.data());
+    screenshot.Format = InGameOverlay::ScreenshotDataFormat_t::R8G8B8A8;
+
+    _SendScreenshot(&screenshot);
+}
+
+bool OpenGLHook_t::_ReadScreenshotAsync(int x, int y, int width, int height, uint32_t targetWidth, uint32_t targetHeight)
+{
+    // Without sync objects, glReadPixels waits for the GPU like before.
+    if ((!GLAD_GL_VERSION_3_2 && !GLAD_GL_ARB_sync) || (!GLAD_GL_VERSION_3_0 && !GLAD_GL_ARB_map_buffer_range) || width <= 0 || height <= 0)
+        return false;
+
+    // The new slots are inserted before the oldest one, the ring stays in order.
+    const size_t ringDepth = _ScreenshotRingDepth();
+    if (_ScreenshotSlots.size() < ringDepth)
+        _ScreenshotSlots.insert(_ScreenshotSlots.begin() + _NextScreenshotSlot, ringDepth - _ScreenshotSlots.size(), ScreenshotSlot_t{});
+
+    auto& slot = _ScreenshotSlots[_NextScreenshotSlot];
+    // Every slot is still read by the GPU, keep the request for the next frame.
+    if (slot.Fence != nullptr)
+        return true;
+
+    const bool canBlit = GLAD_GL_VERSION_3_0 || GLAD_GL_ARB_framebuffer_object;
+
+    GLint oldPackBuffer = 0, oldPackAlignment = 0, oldReadBuffer = 0, oldReadFramebuffer = 0, oldDrawFramebuffer = 0;
+    glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &oldPackBuffer);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &oldPackAlignment);
+    glGetIntegerv(GL_READ_BUFFER, &oldReadBuffer);
+    if (canBlit)
+    {
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &oldReadFramebuffer);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &oldDrawFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    GLboolean isDoubleBuffered = GL_FALSE;
+    glGetBooleanv(GL_DOUBLEBUFFER, &isDoubleBuffered);
+    glReadBuffer(isDoubleBuffered ? GL_BACK : GL_FRONT);
+
+    // A multisampled back buffer can't be blitted upside down, it is resolved by glReadPixels and flipped on the CPU.
+    GLint sampleBuffers = 0;
+    glGetIntegerv(GL_SAMPLE_BUFFERS, &sampleBuffers);
+
+    // Without a blit, the rectangle is read at its size.
+    int readX = x;
+    int readY = y;
+    int readWidth = width;
+    int readHeight = height;
+    slot.Flipped = false;
+    if (canBlit && sampleBuffers == 0)
+    {
+        if (_ScreenshotFramebuffer == 0)
+        {
+            GLuint framebuffer = 0;
+            GLuint renderbuffer = 0;
+            glGenFramebuffers(1, &framebuffer);
+            glGenRenderbuffers(1, &renderbuffer);
+            _ScreenshotFramebuffer = framebuffer;
+            _ScreenshotRenderbuffer = renderbuffer;
+        }
+
+        if (_ScreenshotRenderbufferWidth != targetWidth || _ScreenshotRenderbufferHeight != targetHeight)
+        {
+            GLint oldRenderbuffer = 0;
+            glGetIntegerv(GL_RENDERBUFFER_BINDING, &oldRenderbuffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, _ScreenshotRenderbuffer);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, targetWidth, targetHeight);
+            glBindRenderbuffer(GL_RENDERBUFFER, oldRenderbuffer);
+
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _ScreenshotFramebuffer);
+            glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _ScreenshotRenderbuffer);
+            _ScreenshotRenderbufferWidth = targetWidth;
+            _ScreenshotRenderbufferHeight = targetHeight;
+        }
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _ScreenshotFramebuffer);
+        if (glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE)
+        {
+            // The blit is clipped by the scissor test.
+            const GLboolean scissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+            glDisable(GL_SCISSOR_TEST);
+            // A thumbnail is scaled down by the blit, only its pixels are read back.
+            const bool scaled = targetWidth != uint32_t(width) || targetHeight != uint32_t(height);
+            glBlitFramebuffer(x, y, x + width, y + height, 0, targetHeight, targetWidth, 0, GL_COLOR_BUFFER_BIT, scaled ? GL_LINEAR : GL_NEAREST);
+            if (scissorEnabled)
+                glEnable(GL_SCISSOR_TEST);
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, _ScreenshotFramebuffer);
+            glReadBuffer(GL_COLOR_ATTACHMENT0);
+            readX = 0;
+            readY = 0;
+            readWidth = targetWidth;
+            readHeight = targetHeight;
+            slot.Flipped = true;
+        }
+    }
+
+    if (slot.Buffer == 0)
+    {
+        GLuint buffer = 0;
+        glGenBuffers(1, &buffer);
+        slot.Buffer = buffer;
+        slot.Size = 0;
+    }
+
+    const size_t size = size_t(readWidth) * readHeight * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+    if (slot.Size != size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        slot.Size = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    glReadPixels(readX, readY, readWidth, readHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.Width = readWidth;
+    slot.Height = readHeight;
+    _NextScreenshotSlot = (_NextScreenshotSlot + 1) % _ScreenshotSlots.size();
+
+    if (canBlit)
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, oldReadFramebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, oldDrawFramebuffer);
+    }
+    glReadBuffer(oldReadBuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, oldPackBuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, oldPackAlignment);
+
+    slot.ScreenshotId = _BeginScreenshot();
+    return true;
+}
+
+void OpenGLHook_t::_PollScreenshots()
+{
+    GLint oldPackBuffer = -1;
+
+    // From the oldest to the newest, so the screenshots are sent in order.
+    for (size_t i = 0; i < _ScreenshotSlots.size(); ++i)
+    {
+        auto& slot = _ScreenshotSlots[(_NextScreenshotSlot + i) % _ScreenshotSlots.size()];
+        if (slot.Fence == nullptr)
+            continue;
+
+        if (glClientWaitSync(slot.Fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            break;
+
+        glDeleteSync(slot.Fence);
+        slot.Fence = nullptr;
+
+        if (oldPackBuffer == -1)
+            glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &oldPackBuffer);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+        auto data = reinterpret_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.Size, GL_MAP_READ_BIT));
+        if (data == nullptr)
+        {
+            _SendScreenshot(nullptr, slot.ScreenshotId);
+            continue;
+        }
+
+        const size_t rowSize = size_t(slot.Width) * 4;
+
+        ScreenshotCallbackParameter_t screenshot;
+        screenshot.Width = slot.Width;
+        screenshot.Height = slot.Height;
+        screenshot.Pitch = static_cast<uint32_t>(rowSize);
+        screenshot.Data = data;
+        screenshot.Format = InGameOverlay::ScreenshotDataFormat_t::R8G8B8A8;
+
+        // The multisampled back buffers were read bottom to top.
+        std::vector<uint8_t> flippedData;
+        if (!slot.Flipped)
+        {
+            flippedData.resize(slot.Size);
+            for (uint32_t row = 0; row < slot.Height; ++row)
+                memcpy(flippedData.data() + row * rowSize, data + (slot.Height - row - 1) * rowSize, rowSize);
+
+            screenshot.Data = flippedData.data();
+        }
+
+        _SendScreenshot(&screenshot, slot.ScreenshotId);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+
+    if (oldPackBuffer != -1)
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, oldPackBuffer);
+}
+
+void OpenGLHook_t::_DestroyScreenshotSlots()
+{
+    for (auto& slot : _ScreenshotSlots)
+    {
+        if (slot.Fence != nullptr)
+        {
+            glDeleteSync(slot.Fence);
+            _SendScreenshot(nullptr, slot.ScreenshotId);
+        }
+
+        if (slot.Buffer != 0)
+        {
+            GLuint buffer = slot.Buffer;
+            glDeleteBuffers(1, &buffer);
+        }
+
+    }
+    _ScreenshotSlots.clear();
+    _NextScreenshotSlot = 0;
+
+    if (_ScreenshotFramebuffer != 0)
+    {
+        GLuint framebuffer = _ScreenshotFramebuffer;
+        GLuint renderbuffer = _ScreenshotRenderbuffer;
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteRenderbuffers(1, &renderbuffer);
+        _ScreenshotFramebuffer = 0;
+        _ScreenshotRenderbuffer = 0;
+        _ScreenshotRenderbufferWidth = 0;
+        _ScreenshotRenderbufferHeight = 0;
+    }
+}
+
+BOOL WINAPI OpenGLHook_t::_MyWGLSwapBuffers(HDC hDC)
+{
+    auto inst = OpenGLHook_t::Inst();
+    inst->_PrepareForOverlay(hDC);
+    return inst->_WGLSwapBuffers(hDC);
+}
+
+OpenGLHook_t::OpenGLHook_t():
+    _Hooked(false),
+    _WindowsHooked(false),
+    _Initialized(false),
+    _HookState(OverlayHookState::Removing),
+    _LastWindow(nullptr),
+    _UploadMode(UploadMode_t::Direct),
+    _PersistentMappingSupported(true),
+    _UploadSlotSize(0),
+    _NextUploadSlot(0),
+    _NextScreenshotSlot(0),
+    _ScreenshotFramebuffer(0),
+    _ScreenshotRenderbuffer(0),
+    _ScreenshotRenderbufferWidth(0),
+    _ScreenshotRenderbufferHeight(0),
+    _ImGuiFontAtlas(nullptr),
+    _WGLSwapBuffers(nullptr)
+{
+}
+
+OpenGLHook_t::~OpenGLHook_t()
+{
+    INGAMEOVERLAY_INFO("OpenGL Hook removed");
+
+    if (_WindowsHooked)
+        delete WindowsHook_t::Inst();
+
+    _ResetRenderState(OverlayHookState::Removing);
+
+    _Instance->UnhookAll();
+    _Instance = nullptr;
+}
+
+OpenGLHook_t* OpenGLHook_t::Inst()
+{
+    if (_Instance == nullptr)
+        _Instance = new OpenGLHook_t;
+
+    return _Instance;
+}
+
+const char* OpenGLHook_t::GetLibraryName() const
+{
+    return LibraryName.c_str();
+}
+
+RendererHookType_t OpenGLHook_t::GetRendererHookType() const
+{
+    return RendererHookType_t::OpenGL;
+}
+
+void OpenGLHook_t::LoadFunctions(WGLSwapBuffers_t pfnwglSwapBuffers)
+{
+    _WGLSwapBuffers = pfnwglSwapBuffers;
+}
+
+RendererTextureHandle_t OpenGLHook_t::AllocImageResource()
+{
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    if (glGetError() != GL_NO_ERROR)
+        return RendererTextureHandle_t{};
+
+    auto ptr = std::shared_ptr<RendererTexture_t>(new RendererTexture_t(), [](RendererTexture_t* handle)
+    {
+        if (handle != nullptr)
+        {
+            auto resource = static_cast<GLuint>(handle->ImGuiTextureId);
+            glDeleteTextures(1, &resource);
+            delete handle;
+        }
+    });
+    ptr->ImGuiTextureId = static_cast<uint64_t>(texture);
+
+    return _InsertTexture(std::move(ptr));
+}
+
+bool OpenGLHook_t::IsResourceFormatSupported(ResourceFormat_t format, uint32_t /*width*/, uint32_t /*height*/)
+{
+    switch (format)
+    {
+        case ResourceFormat_t::R8G8B8A8          :
+        case ResourceFormat_t::B8G8R8A8          :
+        case ResourceFormat_t::R5G6B5            : return true;
+        case ResourceFormat_t::A8                : return (GLAD_GL_VERSION_3_3 || GLAD_GL_ARB_texture_swizzle) && (GLAD_GL_VERSION_3_0 || GLAD_GL_ARB_texture_rg);
+        case ResourceFormat_t::R16G16B16A16_FLOAT: return GLAD_GL_VERSION_3_0 || (GLAD_GL_ARB_texture_float && GLAD_GL_ARB_half_float_pixel);
+        case ResourceFormat_t::BC1       :
+        case ResourceFormat_t::BC3       : return GLAD_GL_EXT_texture_compression_s3tc != 0;
+        case ResourceFormat_t::BC7       : return GLAD_GL_ARB_texture_compression_bptc != 0;
+        case ResourceFormat_t::ETC2_RGB8 :
+        case ResourceFormat_t::ETC2_RGBA8: return GLAD_GL_ARB_ES3_compatibility != 0;
+        default                          : return false;
+    }
+}
+
+void OpenGLHook_t::LoadImageResource(RendererTextureLoadParameter_t& loadParameter)
+{
+    _ImageResourcesToLoad.emplace_back(loadParameter);
+}
+
+bool OpenGLHook_t::UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter)
+{
+    _ImageResourcesToUpdate.emplace_back(std::move(updateParameter));
+    return true;
+}
+
+void OpenGLHook_t::ReleaseImageResource(RendererTextureHandle_t resource)
+{
+    auto ptr = _RemoveTexture(resource);
+    if (ptr)
+        _RetireTexture(std::move(ptr));
+}
+
 }// namespace InGameOverlay
\ No newline at end of file
@@ -1,82 +1,147 @@
-/*
- * Copyright (C) Nemirtingas
- * This file is part of the ingame overlay project
- *
- * The ingame overlay project is free software; you can redistribute it
- * and/or modify it under the terms of the GNU Lesser General Public
- * License as published by the Free Software Foundation; either
- * version 3 of the License, or (at your option) any later version.
- * 
- * The ingame overlay project is distributed in the hope that it will be
- * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
- * Lesser General Public License for more details.
- *
- * You should have received a copy of the GNU Lesser General Public
- * License along with the ingame overlay project; if not, see
- * <http://www.gnu.org/licenses/>.
- */
-
-#pragma once
-
-#include "../RendererHookInternal.h"
-
-#include "../InternalIncludes.h"
-
-namespace InGameOverlay {
-
-class OpenGLHook_t :
-    public InGameOverlay::RendererHookInternal_t,
-    public BaseHook_t
-{
-public:
-    using WGLSwapBuffers_t = BOOL(WINAPI*)(HDC);
-
-private:
-    static OpenGLHook_t* _Instance;
-
-    // Variables
-    bool _Hooked;
-    bool _WindowsHooked;
-    bool _Initialized;
-    OverlayHookState _HookState;
-    HWND _LastWindow;
-    std::set<std::shared_ptr<RendererTexture_t>> _ImageResources;
-    std::vector<RendererTextureLoadParameter_t> _ImageResourcesToLoad;
-    std::vector<RendererTextureReleaseParameter_t> _ImageResourcesToRelease;
-    void* _ImGuiFontAtlas;
-
-    // Functions
-    OpenGLHook_t();
-
-    void _ResetRenderState(OverlayHookState state);
-    void _PrepareForOverlay(HDC hDC);
-    void _LoadResources();
-    void _ReleaseResources();
-    void _HandleScreenshot();
-
-    // Hook to render functions
-    WGLSwapBuffers_t _WGLSwapBuffers;
-
-    static BOOL WINAPI _MyWGLSwapBuffers(HDC hDC);
-
-public:
-    std::string LibraryName;
-
-    virtual ~OpenGLHook_t();
-
-    virtual bool StartHook(std::function<void()> keyCombinationCallback, ToggleKey toggleKeys[], int toggleKeysCount, /*ImFontAtlas* */ void* imguiFontAtlas = nullptr);
-    virtual void HideAppInputs(bool hide);
-    virtual void HideOverlayInputs(bool hide);
-    virtual bool IsStarted();
-    static OpenGLHook_t* Inst();
-    virtual const char* GetLibraryName() const;
-    virtual RendererHookType_t GetRendererHookType() const;
-    void LoadFunctions(WGLSwapBuffers_t pfnwglSwapBuffers);
-
-    virtual std::weak_ptr<RendererTexture_t> AllocImageResource();
-    virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter);
-    virtual void ReleaseImageResource(std::weak_ptr<RendererTexture_t> resource);
-};
-
+/*
+ * Copyright (C) Nemirtingas
+ * This file is part of the ingame overlay project
+ *
+ * The ingame overlay project is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * The ingame overlay project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the ingame overlay project; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../RendererHookInternal.h"
+
+#include "../InternalIncludes.h"
+
+namespace InGameOverlay {
+
+class OpenGLHook_t :
+    public InGameOverlay::RendererHookInternal_t,
+    public BaseHook_t
+{
+public:
+    using WGLSwapBuffers_t = BOOL(WINAPI*)(HDC);
+
+private:
+    static OpenGLHook_t* _Instance;
+
+    constexpr static uint32_t UploadSlotCount = 3;
+
+    enum class UploadMode_t : uint8_t
+    {
+        // glTexImage2D from the client memory, used when the context has no sync objects.
+        Direct,
+        // Pixel buffer objects written with glMapBufferRange(GL_MAP_UNSYNCHRONIZED_BIT).
+        Unsynchronized,
+        // Pixel buffer objects persistently mapped (GL_ARB_buffer_storage).
+        Persistent,
+    };
+
+    // A pixel buffer object, it can be written again once the fence of its last upload is signaled.
+    struct UploadSlot_t
+    {
+        uint32_t Buffer = 0;
+        uint8_t* MappedData = nullptr;
+        struct __GLsync* Fence = nullptr;
+        std::vector<std::shared_ptr<RendererTexture_t>> Textures;
+    };
+
+    // A pixel pack buffer a screenshot is read in, it is mapped and sent once its fence is signaled.
+    struct ScreenshotSlot_t
+    {
+        uint32_t Buffer = 0;
+        size_t Size = 0;
+        struct __GLsync* Fence = nullptr;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        // Returned by _BeginScreenshot.
+        uint64_t ScreenshotId = 0;
+        // Set when the GPU flipped the rows top to bottom, the mapped buffer is sent as it is.
+        bool Flipped = false;
+    };
+
+    // Signaled once the GPU executed the overlay commands of the frame.
+    struct FrameFence_t
+    {
+        uint64_t Frame;
+        struct __GLsync* Fence;
+    };
+
+    // Variables
+    bool _Hooked;
+    bool _WindowsHooked;
+    bool _Initialized;
+    OverlayHookState _HookState;
+    HWND _LastWindow;
+    std::vector<RendererTextureLoadParameter_t> _ImageResourcesToLoad;
+    std::vector<RendererTextureUpdateParameter_t> _ImageResourcesToUpdate;
+    UploadMode_t _UploadMode;
+    bool _PersistentMappingSupported;
+    size_t _UploadSlotSize;
+    uint32_t _NextUploadSlot;
+    UploadSlot_t _UploadSlots[UploadSlotCount];
+    std::deque<FrameFence_t> _FrameFences;
+    // Ring of readback buffers, it grows to the capture ring depth.
+    std::vector<ScreenshotSlot_t> _ScreenshotSlots;
+    uint32_t _NextScreenshotSlot;
+    // The screenshot rectangle is blitted upside down in it before being read, scaled down to the screenshot size.
+    uint32_t _ScreenshotFramebuffer;
+    uint32_t _ScreenshotRenderbuffer;
+    uint32_t _ScreenshotRenderbufferWidth;
+    uint32_t _ScreenshotRenderbufferHeight;
+    void* _ImGuiFontAtlas;
+
+    // Functions
+    OpenGLHook_t();
+
+    void _ResetRenderState(OverlayHookState state);
+    void _PrepareForOverlay(HDC hDC);
+    bool _CreateUploadSlots();
+    void _DestroyUploadSlots();
+    void _PollUploadSlots();
+    void _DestroyFrameFences();
+    void _LoadResources();
+    void _ReleaseResources();
+    void _HandleScreenshot();
+    bool _ReadScreenshotAsync(int x, int y, int width, int height, uint32_t targetWidth, uint32_t targetHeight);
+    void _PollScreenshots();
+    void _DestroyScreenshotSlots();
+
+    // Hook to render functions
+    WGLSwapBuffers_t _WGLSwapBuffers;
+
+    static BOOL WINAPI _MyWGLSwapBuffers(HDC hDC);
+
+public:
+    std::string LibraryName;
+
+    virtual ~OpenGLHook_t();
+
+    virtual bool StartHook(std::function<void()> keyCombinationCallback, ToggleKey toggleKeys[], int toggleKeysCount, /*ImFontAtlas* */ void* imguiFontAtlas = nullptr);
+    virtual void HideAppInputs(bool hide);
+    virtual void HideOverlayInputs(bool hide);
+    virtual bool IsStarted();
+    static OpenGLHook_t* Inst();
+    virtual const char* GetLibraryName() const;
+    virtual RendererHookType_t GetRendererHookType() const;
+    void LoadFunctions(WGLSwapBuffers_t pfnwglSwapBuffers);
+
+    virtual RendererTextureHandle_t AllocImageResource();
+    virtual bool IsResourceFormatSupported(ResourceFormat_t format, uint32_t width, uint32_t height);
+
+    virtual void LoadImageResource(RendererTextureLoadParameter_t& loadParameter);
+    virtual bool UpdateImageResource(RendererTextureUpdateParameter_t& updateParameter);
+    virtual void ReleaseImageResource(RendererTextureHandle_t resource);
+};
+
 }// namespace InGameOverlay
\ No newline at end of file
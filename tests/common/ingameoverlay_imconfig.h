@@ -1,5 +1,5 @@
-#pragma once
-
-#include <stdint.h>
-// ImTextureID [configurable type: override in imconfig.h with '#define ImTextureID xxx']
+#pragma once
+
+#include <stdint.h>
+// ImTextureID [configurable type: override in imconfig.h with '#define ImTextureID xxx']
 #define ImTextureID uint64_t
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include <InGameOverlay/ScreenshotConverter.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace InGameOverlay;
+
+struct FormatName_t
+{
+    ScreenshotDataFormat_t Format;
+    const char* Name;
+};
+
+static constexpr FormatName_t Formats[] = {
+    { ScreenshotDataFormat_t::R8G8B8            , "R8G8B8"             },
+    { ScreenshotDataFormat_t::X8R8G8B8          , "X8R8G8B8"           },
+    { ScreenshotDataFormat_t::A8R8G8B8          , "A8R8G8B8"           },
+    { ScreenshotDataFormat_t::B8G8R8A8          , "B8G8R8A8"           },
+    { ScreenshotDataFormat_t::B8G8R8X8          , "B8G8R8X8"           },
+    { ScreenshotDataFormat_t::R8G8B8A8          , "R8G8B8A8"           },
+    { ScreenshotDataFormat_t::A2R10G10B10       , "A2R10G10B10"        },
+    { ScreenshotDataFormat_t::A2B10G10R10       , "A2B10G10R10"        },
+    { ScreenshotDataFormat_t::R10G10B10A2       , "R10G10B10A2"        },
+    { ScreenshotDataFormat_t::R5G6B5            , "R5G6B5"             },
+    { ScreenshotDataFormat_t::X1R5G5B5          , "X1R5G5B5"           },
+    { ScreenshotDataFormat_t::A1R5G5B5          , "A1R5G5B5"           },
+    { ScreenshotDataFormat_t::B5G6R5            , "B5G6R5"             },
+    { ScreenshotDataFormat_t::B5G5R5A1          , "B5G5R5A1"           },
+    { ScreenshotDataFormat_t::R16G16B16A16_FLOAT, "R16G16B16A16_FLOAT" },
+    { ScreenshotDataFormat_t::R16G16B16A16_UNORM, "R16G16B16A16_UNORM" },
+    { ScreenshotDataFormat_t::R32G32B32A32_FLOAT, "R32G32B32A32_FLOAT" },
+};
+
+static constexpr ScreenshotConverterPath_t Paths[] = {
+    ScreenshotConverterPath_t::Scalar,
+    ScreenshotConverterPath_t::SSE2,
+    ScreenshotConverterPath_t::AVX2,
+    ScreenshotConverterPath_t::NEON,
+};
+
+static const char* PathName(ScreenshotConverterPath_t path)
+{
+    switch (path)
+    {
+        case ScreenshotConverterPath_t::Scalar: return "Scalar";
+        case ScreenshotConverterPath_t::SSE2  : return "SSE2";
+        case ScreenshotConverterPath_t::AVX2  : return "AVX2";
+        case ScreenshotConverterPath_t::NEON  : return "NEON";
+        default:                                return "Auto";
+    }
+}
+
+// Random bits, the float formats also get values in [0, 1] so the rounding is tested and not only the clamps.
+// Without edge cases, the floats are only normal values in [0, 1] like in a real back buffer: the denormals are slow on some CPUs.
+static std::vector<uint8_t> MakePixels(ScreenshotDataFormat_t format, size_t size, std::mt19937& rng, bool edgeCases)
+{
+    std::vector<uint8_t> pixels(size);
+    for (auto& byte : pixels)
+        byte = static_cast<uint8_t>(rng());
+
+    if (format == ScreenshotDataFormat_t::R32G32B32A32_FLOAT)
+    {
+        std::uniform_real_distribution<float> unit(edgeCases ? -0.1f : 0.0f, edgeCases ? 1.1f : 1.0f);
+        for (size_t i = 0; i + 4 <= size; i += 4)
+        {
+            if (!edgeCases || rng() % 4 != 0)
+            {
+                const float value = unit(rng);
+                memcpy(&pixels[i], &value, sizeof(value));
+            }
+        }
+    }
+    else if (format == ScreenshotDataFormat_t::R16G16B16A16_FLOAT)
+    {
+        for (size_t i = 1; i < size; i += 2)
+        {
+            // Clears the sign and the high exponent bit of most halves, they land in [0, 2).
+            if (edgeCases && rng() % 4 != 0)
+                pixels[i] &= 0x3f;
+            // Exponents from 1 to 14.
+            else if (!edgeCases)
+                pixels[i] = static_cast<uint8_t>(0x04 + rng() % (0x3c - 0x04));
+        }
+    }
+
+    return pixels;
+}
+
+static bool CheckReferenceValues()
+{
+    struct Reference_t
+    {
+        ScreenshotDataFormat_t Format;
+        uint8_t Input[16];
+        uint8_t Expected[4];
+    };
+
+    static const Reference_t references[] = {
+        { ScreenshotDataFormat_t::X8R8G8B8          , { 0x10, 0x20, 0x30, 0x00 }, { 0x30, 0x20, 0x10, 0xff } },
+        { ScreenshotDataFormat_t::R8G8B8            , { 0x10, 0x20, 0x30 }      , { 0x30, 0x20, 0x10, 0xff } },
+        // R = 1023, G = 512, B = 0, A = 1
+        { ScreenshotDataFormat_t::R10G10B10A2       , { 0xff, 0x03, 0x08, 0x40 }, { 0xff, 0x80, 0x00, 0x55 } },
+        { ScreenshotDataFormat_t::A2R10G10B10       , { 0xff, 0x03, 0x08, 0x40 }, { 0x00, 0x80, 0xff, 0x55 } },
+        // R = 31, G = 0, B = 16
+        { ScreenshotDataFormat_t::R5G6B5            , { 0x10, 0xf8 }            , { 0xff, 0x00, 0x84, 0xff } },
+        // R = 0, G = 31, B = 0, A = 1
+        { ScreenshotDataFormat_t::A1R5G5B5          , { 0xe0, 0x83 }            , { 0x00, 0xff, 0x00, 0xff } },
+        // 1.0, 0.5, -2.0, +inf
+        { ScreenshotDataFormat_t::R16G16B16A16_FLOAT, { 0x00, 0x3c, 0x00, 0x38, 0x00, 0xc0, 0x00, 0x7c }, { 0xff, 0x80, 0x00, 0xff } },
+        { ScreenshotDataFormat_t::R16G16B16A16_UNORM, { 0xff, 0xff, 0x80, 0x80, 0x00, 0x00, 0x7f, 0x00 }, { 0xff, 0x80, 0x00, 0x00 } },
+        // 1.0, 0.5, 2.0, -1.0
+        { ScreenshotDataFormat_t::R32G32B32A32_FLOAT, { 0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x80, 0xbf }, { 0xff, 0x80, 0xff, 0x00 } },
+    };
+
+    bool success = true;
+    for (auto const& reference : references)
+    {
+        for (auto path : Paths)
+        {
+            uint8_t output[4];
+            ConvertScreenshotData(reference.Format, reference.Input, 1, 1, 0, ScreenshotOutputFormat_t::R8G8B8A8, output, 0, path);
+            if (memcmp(output, reference.Expected, 4) != 0)
+            {
+                printf("Reference %d with %s: got %02x%02x%02x%02x\n", int(reference.Format), PathName(path), output[0], output[1], output[2], output[3]);
+                success = false;
+            }
+        }
+    }
+
+    return success;
+}
+
+static bool CheckPaths(std::mt19937& rng)
+{
+    bool success = true;
+    for (auto const& format : Formats)
+    {
+        const uint32_t pixelSize = GetScreenshotFormatPixelSize(format.Format);
+        for (uint32_t width : { 1u, 3u, 7u, 8u, 15u, 16u, 17u, 33u, 257u })
+        {
+            const uint32_t height = 5;
+            // Padded rows, the padding must not be written.
+            const uint32_t pitch = width * pixelSize + 12;
+            const uint32_t outputPitch = width * 4 + 8;
+            const auto pixels = MakePixels(format.Format, size_t(pitch) * height, rng, true);
+
+            for (auto outputFormat : { ScreenshotOutputFormat_t::R8G8B8A8, ScreenshotOutputFormat_t::B8G8R8A8 })
+            {
+                std::vector<uint8_t> expected(size_t(outputPitch) * height, 0xcd);
+                ConvertScreenshotData(format.Format, pixels.data(), width, height, pitch, outputFormat, expected.data(), outputPitch, ScreenshotConverterPath_t::Scalar);
+
+                for (auto path : Paths)
+                {
+                    std::vector<uint8_t> output(expected.size(), 0xcd);
+                    ConvertScreenshotData(format.Format, pixels.data(), width, height, pitch, outputFormat, output.data(), outputPitch, path);
+                    if (output != expected)
+                    {
+                        printf("%s with %s differs from Scalar, width %u\n", format.Name, PathName(path), width);
+                        success = false;
+                    }
+
+                    if (pixelSize == 4)
+                    {
+                        std::vector<uint8_t> inPlace(pixels.begin(), pixels.begin() + size_t(pitch) * height);
+                        ConvertScreenshotData(format.Format, inPlace.data(), width, height, pitch, outputFormat, inPlace.data(), pitch, path);
+                        for (uint32_t row = 0; row < height; ++row)
+                        {
+                            if (memcmp(&inPlace[size_t(row) * pitch], &expected[size_t(row) * outputPitch], width * 4) != 0)
+                            {
+                                printf("%s with %s differs in place, width %u\n", format.Name, PathName(path), width);
+                                success = false;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return success;
+}
+
+static void Benchmark(std::mt19937& rng)
+{
+    const uint32_t width = 1920;
+    const uint32_t height = 1080;
+    const int iterations = 20;
+    std::vector<uint8_t> output(size_t(width) * height * 4);
+
+    printf("%-20s", "Mpixels/s");
+    for (auto path : Paths)
+        printf("%10s", PathName(path));
+    printf("\n");
+
+    for (auto const& format : Formats)
+    {
+        const auto pixels = MakePixels(format.Format, size_t(width) * height * GetScreenshotFormatPixelSize(format.Format), rng, false);
+        printf("%-20s", format.Name);
+        for (auto path : Paths)
+        {
+            // The paths falling back to another one are not measured twice.
+            if (GetScreenshotConverterPath(format.Format, path) != path)
+            {
+                printf("%10s", "-");
+                continue;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i)
+                ConvertScreenshotData(format.Format, pixels.data(), width, height, 0, ScreenshotOutputFormat_t::R8G8B8A8, output.data(), 0, path);
+
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            printf("%10.0f", double(width) * height * iterations / elapsed.count() / 1e6);
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::mt19937 rng(1234);
+
+    const bool success = CheckReferenceValues() && CheckPaths(rng);
+    printf("Conversion paths: %s\n", success ? "identical" : "FAILED");
+
+    if (success && !(argc > 1 && strcmp(argv[1], "--no-benchmark") == 0))
+        Benchmark(rng);
+
+    return success ? 0 : 1;
+}
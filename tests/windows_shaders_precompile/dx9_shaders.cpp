@@ -1,3 +1,3 @@
-#include <d3dcompiler.h>
-
+#include <d3dcompiler.h>
+
 #include "shaders.h"
\ No newline at end of file